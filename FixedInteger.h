@@ -0,0 +1,802 @@
+// -----------------------
+// integer/FixedInteger.h
+// Tj Wrenn
+// -----------------------
+
+#ifndef FixedInteger_h
+#define FixedInteger_h
+
+// --------
+// includes
+// --------
+
+#include <cassert>     // assert
+#include <cstddef>     // size_t
+#include <cstdint>     // uint32_t, uint64_t
+#include <iostream>    // ostream
+#include <stdexcept>   // invalid_argument, overflow_error
+#include <string>      // string
+#include <type_traits> // is_same
+
+// ----------
+// namespaces
+// ----------
+
+namespace alg   {
+	namespace prog    {
+		namespace integer {
+
+			// ----------------
+			// overflow policies
+			// ----------------
+
+			/**
+			* results whose magnitude does not fit in Bits bits throw std::overflow_error
+			*/
+			struct checked {};
+
+			/**
+			* results whose magnitude does not fit in Bits bits are reduced modulo 2^Bits, keeping their sign
+			*/
+			struct wrapping {};
+
+			// ------------
+			// FixedInteger
+			// ------------
+
+			/**
+			* a signed integer whose magnitude has at most Bits bits, stored inline in 32 bit limbs.
+			* every operation is constexpr and every loop runs over the compile time LIMBS constant
+			* so that the compiler can unroll it.  The arithmetic follows Integer: sign and magnitude,
+			* division truncates toward zero, and % requires a non-negative lhs and positive rhs.
+			*/
+			template < std::size_t Bits, typename Overflow = checked >
+			class FixedInteger {
+				static_assert(Bits > 0, "FixedInteger needs at least one bit");
+				static_assert(std::is_same<Overflow, checked>::value || std::is_same<Overflow, wrapping>::value,
+				              "FixedInteger overflow policy must be checked or wrapping");
+
+				// -------
+				// friends
+				// -------
+
+				/**
+				* O(1)
+				* M(1)
+				* @param x a FixedInteger
+				* @return a new FixedInteger by negating x
+				*/
+				friend constexpr FixedInteger operator - (FixedInteger x) {
+					x.sign = !x.sign && !x.isZero();
+					return x;}
+
+				/**
+				* O(LIMBS)
+				* M(1)
+				* @param lhs a FixedInteger
+				* @param rhs a FixedInteger
+				* @return a new FixedInteger by adding lhs and rhs
+				* @throws std::overflow_error
+				*/
+				friend constexpr FixedInteger operator + (FixedInteger lhs, const FixedInteger& rhs) throw (std::overflow_error) {
+					return lhs += rhs;}
+
+				/**
+				* O(LIMBS)
+				* M(1)
+				* @param lhs a FixedInteger
+				* @param rhs a FixedInteger
+				* @return a new FixedInteger by subtracting rhs from lhs
+				* @throws std::overflow_error
+				*/
+				friend constexpr FixedInteger operator - (FixedInteger lhs, const FixedInteger& rhs) throw (std::overflow_error) {
+					return lhs -= rhs;}
+
+				/**
+				* O(LIMBS^2)
+				* M(1)
+				* @param lhs a FixedInteger
+				* @param rhs a FixedInteger
+				* @return a new FixedInteger by multiplying lhs and rhs
+				* @throws std::overflow_error
+				*/
+				friend constexpr FixedInteger operator * (FixedInteger lhs, const FixedInteger& rhs) throw (std::overflow_error) {
+					return lhs *= rhs;}
+
+				/**
+				* O(LIMBS^2)
+				* M(1)
+				* @param lhs a FixedInteger
+				* @param rhs a FixedInteger
+				* @return a new FixedInteger by dividing lhs by rhs
+				* @throws std::invalid_argument
+				*/
+				friend constexpr FixedInteger operator / (FixedInteger lhs, const FixedInteger& rhs) throw (std::invalid_argument) {
+					return lhs /= rhs;}
+
+				/**
+				* O(LIMBS^2)
+				* M(1)
+				* @param lhs a FixedInteger
+				* @param rhs a FixedInteger
+				* @return a new FixedInteger by modding lhs by rhs
+				* @throws std::invalid_argument
+				*/
+				friend constexpr FixedInteger operator % (FixedInteger lhs, const FixedInteger& rhs) throw (std::invalid_argument) {
+					return lhs %= rhs;}
+
+				/**
+				* O(LIMBS)
+				* M(1)
+				* @param lhs a FixedInteger
+				* @param rhs a FixedInteger
+				* @return true if lhs is equal to rhs
+				*/
+				friend constexpr bool operator == (const FixedInteger& lhs, const FixedInteger& rhs) {
+					return lhs.sign == rhs.sign && compare(lhs.limbs, rhs.limbs) == 0;}
+
+				/**
+				* O(LIMBS)
+				* M(1)
+				* @param lhs a FixedInteger
+				* @param rhs a FixedInteger
+				* @return true if lhs is not equal to rhs
+				*/
+				friend constexpr bool operator != (const FixedInteger& lhs, const FixedInteger& rhs) {
+					return !(lhs == rhs);}
+
+				/**
+				* O(LIMBS)
+				* M(1)
+				* @param lhs a FixedInteger
+				* @param rhs a FixedInteger
+				* @return true if lhs is less than rhs
+				*/
+				friend constexpr bool operator < (const FixedInteger& lhs, const FixedInteger& rhs) {
+					if(lhs.sign != rhs.sign) return lhs.sign;
+					return lhs.sign ? compare(rhs.limbs, lhs.limbs) < 0 : compare(lhs.limbs, rhs.limbs) < 0;}
+
+				/**
+				* O(LIMBS)
+				* M(1)
+				* @param lhs a FixedInteger
+				* @param rhs a FixedInteger
+				* @return true if lhs is less than or equal to rhs
+				*/
+				friend constexpr bool operator <= (const FixedInteger& lhs, const FixedInteger& rhs) {
+					return !(rhs < lhs);}
+
+				/**
+				* O(LIMBS)
+				* M(1)
+				* @param lhs a FixedInteger
+				* @param rhs a FixedInteger
+				* @return true if lhs is greater than rhs
+				*/
+				friend constexpr bool operator > (const FixedInteger& lhs, const FixedInteger& rhs) {
+					return (rhs < lhs);}
+
+				/**
+				* O(LIMBS)
+				* M(1)
+				* @param lhs a FixedInteger
+				* @param rhs a FixedInteger
+				* @return true if lhs is greater than or equal to rhs
+				*/
+				friend constexpr bool operator >= (const FixedInteger& lhs, const FixedInteger& rhs) {
+					return !(lhs < rhs);}
+
+				/**
+				* O(LIMBS^2)
+				* M(LIMBS)
+				* @param lhs an ostream
+				* @param rhs a FixedInteger
+				* @return the ostream
+				*/
+				friend std::ostream& operator << (std::ostream& lhs, const FixedInteger& rhs) {
+					//peel off nine decimal digits at a time, least significant chunk first
+					limb_type chunks[(Bits + 28) / 29 + 1] = {};
+					std::size_t n = 0;
+					limb_type x[LIMBS] = {};
+					copy(rhs.limbs, x);
+					do{
+						chunks[n++] = divideSmall(x, 1000000000u);
+					} while(!isZero(x));
+
+					if(rhs.sign) lhs << "-";
+					lhs << chunks[--n];
+					while(n){
+						const limb_type chunk = chunks[--n];
+						for(limb_type place = 100000000u; place > chunk && place > 1; place /= 10)
+							lhs << '0';
+						lhs << chunk;
+					}
+					return lhs;}
+
+			public:
+				// --------
+				// typedefs
+				// --------
+
+				typedef std::uint32_t limb_type;
+				typedef std::uint64_t wide_type;
+				typedef Overflow      overflow_policy;
+
+				/**
+				* the number of 32 bit limbs holding the magnitude
+				*/
+				enum { LIMBS = (Bits + 31) / 32 };
+
+				static const FixedInteger ZERO;
+				static const FixedInteger ONE;
+			private:
+				// ----
+				// data
+				// ----
+
+				limb_type limbs[LIMBS]; //least significant limb first
+				bool sign;
+
+				// -------
+				// isDigit
+				// -------
+
+				/**
+				* O(1)
+				* M(1)
+				* @param char c
+				* @return true if c is a digit
+				*/
+				static constexpr bool isDigit (char c) {
+					return c >= '0' && c <= '9';}
+
+				// -------
+				// topMask
+				// -------
+
+				/**
+				* O(1)
+				* M(1)
+				* @return the bits of the most significant limb that belong to the magnitude
+				*/
+				static constexpr limb_type topMask () {
+					return (Bits % 32) ? (limb_type(1) << (Bits % 32)) - 1 : ~limb_type(0);}
+
+				// --------
+				// overflow
+				// --------
+
+				/**
+				* O(1)
+				* M(1)
+				* applies the overflow policy to a magnitude whose bits above Bits may be set
+				* @param x the magnitude
+				* @param carried true if bits above the LIMBS limbs were discarded to produce x
+				* @param where the operation to name in the exception
+				* @throws std::overflow_error
+				*/
+				static constexpr void overflow (limb_type* x, bool carried, const char* where) throw (std::overflow_error) {
+					if(!carried && !(x[LIMBS-1] & ~topMask())) return;
+					if(std::is_same<Overflow, checked>::value)
+						throw std::overflow_error(where);
+					x[LIMBS-1] &= topMask();}
+
+				// -----------------
+				// magnitude helpers
+				// -----------------
+
+				/**
+				* O(LIMBS)
+				* M(1)
+				* @return true if the magnitude x is zero
+				*/
+				static constexpr bool isZero (const limb_type* x) {
+					limb_type bits = 0;
+					for(std::size_t i=0; i<LIMBS; ++i)
+						bits |= x[i];
+					return !bits;}
+
+				/**
+				* O(LIMBS)
+				* M(1)
+				* @return true if *this is zero
+				*/
+				constexpr bool isZero () const {
+					return isZero(limbs);}
+
+				/**
+				* O(LIMBS)
+				* M(1)
+				* @param from the magnitude to copy
+				* @param to receives the LIMBS limbs of from
+				*/
+				static constexpr void copy (const limb_type* from, limb_type* to) {
+					for(std::size_t i=0; i<LIMBS; ++i)
+						to[i] = from[i];}
+
+				/**
+				* O(LIMBS)
+				* M(1)
+				* @return negative, zero or positive as the magnitude x is less than, equal to, or greater than y
+				*/
+				static constexpr int compare (const limb_type* x, const limb_type* y) {
+					for(std::size_t i=LIMBS; i--; ){
+						if(x[i] != y[i]) return x[i] < y[i] ? -1 : 1;
+					}
+					return 0;}
+
+				/**
+				* O(LIMBS)
+				* M(1)
+				* x += y
+				* @return true if there was a carry out of the top limb
+				*/
+				static constexpr bool add (limb_type* x, const limb_type* y) {
+					wide_type carry = 0;
+					for(std::size_t i=0; i<LIMBS; ++i){
+						carry += wide_type(x[i]) + y[i];
+						x[i] = limb_type(carry);
+						carry >>= 32;
+					}
+					return carry;}
+
+				/**
+				* O(LIMBS)
+				* M(1)
+				* x -= y where x >= y
+				*/
+				static constexpr void subtract (limb_type* x, const limb_type* y) {
+					limb_type borrow = 0;
+					for(std::size_t i=0; i<LIMBS; ++i){
+						const wide_type diff = wide_type(x[i]) - y[i] - borrow;
+						x[i] = limb_type(diff);
+						borrow = limb_type(diff >> 63);
+					}
+					assert(!borrow);}
+
+				/**
+				* O(LIMBS)
+				* M(1)
+				* x /= d
+				* @return x % d
+				*/
+				static constexpr limb_type divideSmall (limb_type* x, limb_type d) {
+					wide_type rem = 0;
+					for(std::size_t i=LIMBS; i--; ){
+						const wide_type cur = (rem << 32) | x[i];
+						x[i] = limb_type(cur / d);
+						rem = cur % d;
+					}
+					return limb_type(rem);}
+
+				/**
+				* O(LIMBS)
+				* M(1)
+				* x = x*m + a
+				* @return true if there was a carry out of the top limb
+				*/
+				static constexpr bool multiplySmall (limb_type* x, limb_type m, limb_type a) {
+					wide_type carry = a;
+					for(std::size_t i=0; i<LIMBS; ++i){
+						carry += wide_type(x[i]) * m;
+						x[i] = limb_type(carry);
+						carry >>= 32;
+					}
+					return carry;}
+
+				/**
+				* O(LIMBS^2)
+				* M(1)
+				* Knuth's algorithm D on 32 bit limbs
+				* @param u the dividend
+				* @param v the divisor, which must not be zero
+				* @param q receives u / v
+				* @param r receives u % v
+				*/
+				static constexpr void divide (const limb_type* u, const limb_type* v, limb_type* q, limb_type* r) {
+					std::size_t n = LIMBS;
+					while(!v[n-1]) --n;
+					std::size_t m = LIMBS;
+					while(m && !u[m-1]) --m;
+
+					for(std::size_t i=0; i<LIMBS; ++i)
+						q[i] = r[i] = 0;
+
+					if(m < n || (m == n && compare(u, v) < 0)){
+						copy(u, r);
+						return;
+					}
+
+					if(LIMBS == 1 || n == 1){
+						copy(u, q);
+						r[0] = divideSmall(q, v[0]);
+						return;
+					}
+
+					//normalise so that the top bit of the divisor is set
+					unsigned s = 0;
+					while(!(v[n-1] & (limb_type(1) << (31-s)))) ++s;
+
+					limb_type vn[LIMBS] = {};
+					limb_type un[LIMBS+1] = {};
+					for(std::size_t i=n-1; i>0; --i)
+						vn[i] = s ? (v[i] << s) | (v[i-1] >> (32-s)) : v[i];
+					vn[0] = v[0] << s;
+					un[m] = s ? u[m-1] >> (32-s) : 0;
+					for(std::size_t i=m-1; i>0; --i)
+						un[i] = s ? (u[i] << s) | (u[i-1] >> (32-s)) : u[i];
+					un[0] = u[0] << s;
+
+					for(std::size_t j=m-n+1; j--; ){
+						//estimate the quotient limb from the top two limbs of the remainder
+						const wide_type top = (wide_type(un[j+n]) << 32) | un[j+n-1];
+						wide_type qhat = top / vn[n-1];
+						wide_type rhat = top % vn[n-1];
+						while(qhat >> 32 || qhat * vn[n-2] > ((rhat << 32) | un[j+n-2])){
+							--qhat;
+							rhat += vn[n-1];
+							if(rhat >> 32) break;
+						}
+
+						//multiply and subtract
+						wide_type carry = 0;
+						limb_type borrow = 0;
+						for(std::size_t i=0; i<n; ++i){
+							const wide_type prod = qhat * vn[i] + carry;
+							carry = prod >> 32;
+							const wide_type diff = wide_type(un[i+j]) - limb_type(prod) - borrow;
+							un[i+j] = limb_type(diff);
+							borrow = limb_type(diff >> 63);
+						}
+						const wide_type diff = wide_type(un[j+n]) - carry - borrow;
+						un[j+n] = limb_type(diff);
+
+						//the estimate was one too large, add the divisor back
+						if(diff >> 63){
+							--qhat;
+							carry = 0;
+							for(std::size_t i=0; i<n; ++i){
+								carry += wide_type(un[i+j]) + vn[i];
+								un[i+j] = limb_type(carry);
+								carry >>= 32;
+							}
+							un[j+n] += limb_type(carry);
+						}
+						q[j] = limb_type(qhat);
+					}
+
+					//denormalise the remainder
+					for(std::size_t i=0; i<n-1; ++i)
+						r[i] = s ? (un[i] >> s) | (un[i+1] << (32-s)) : un[i];
+					r[n-1] = un[n-1] >> s;}
+
+				// -----
+				// parse
+				// -----
+
+				/**
+				* O(n*LIMBS)
+				* M(1)
+				* @param first the first character of a positive or negative number in base 10
+				* @param last one past the last character
+				* @throws std::invalid_argument
+				* @throws std::overflow_error
+				*/
+				constexpr void parse (const char* first, const char* last) throw (std::invalid_argument, std::overflow_error) {
+					if(first != last && '-' == *first){
+						++first;
+						sign = true;
+					}
+					if(first == last) //handles "" and "-"
+						throw std::invalid_argument("FixedInteger::FixedInteger()");
+					for(; first != last; ++first){
+						if(!isDigit(*first))
+							throw std::invalid_argument("FixedInteger::FixedInteger()");
+						overflow(limbs, multiplySmall(limbs, 10, *first - '0'), "FixedInteger::FixedInteger()");
+					}
+					if(isZero()) sign = false; //eliminate negative zero
+				}
+
+			public:
+				// ------------
+				// constructors
+				// ------------
+
+				/**
+				* O(LIMBS)
+				* M(1)
+				* @param i a positive or negative number
+				* @throws std::overflow_error
+				*/
+				constexpr FixedInteger (long long i) throw (std::overflow_error) : limbs(), sign(i < 0) {
+					//negate in unsigned arithmetic so that LLONG_MIN survives
+					unsigned long long u = sign ? 0ull - static_cast<unsigned long long>(i) : static_cast<unsigned long long>(i);
+					for(std::size_t k=0; k<LIMBS && u; ++k){
+						limbs[k] = limb_type(u);
+						u >>= 32;
+					}
+					overflow(limbs, u != 0, "FixedInteger::FixedInteger()");
+					if(isZero()) sign = false;}
+
+				/**
+				* O(n*LIMBS)
+				* M(1)
+				* @param s the string representation of a positive or negative number in base 10
+				* @throws std::invalid_argument
+				* @throws std::overflow_error
+				*/
+				template < std::size_t N >
+				constexpr explicit FixedInteger (const char (&s)[N]) throw (std::invalid_argument, std::overflow_error) : limbs(), sign(false) {
+					parse(s, s + N - 1);}
+
+				/**
+				* O(n*LIMBS)
+				* M(1)
+				* @param s the string representation of a positive or negative number in base 10
+				* @throws std::invalid_argument
+				* @throws std::overflow_error
+				*/
+				explicit FixedInteger (const std::string& s) throw (std::invalid_argument, std::overflow_error) : limbs(), sign(false) {
+					parse(s.data(), s.data() + s.size());}
+
+				// Default copy, destructor, and copy assignment.
+				// FixedInteger (const FixedInteger&);
+				// ~FixedInteger ();
+				// FixedInteger& operator = (const FixedInteger&);
+
+				// -----------
+				// operator ++
+				// -----------
+
+				/**
+				* O(LIMBS)
+				* M(1)
+				* @return the incremented FixedInteger *this
+				* @throws std::overflow_error
+				*/
+				constexpr FixedInteger& operator ++ () throw (std::overflow_error) {
+					return *this += FixedInteger(1);}
+
+				/**
+				* O(LIMBS)
+				* M(1)
+				* @return copy of *this
+				* @throws std::overflow_error
+				*/
+				constexpr FixedInteger operator ++ (int) throw (std::overflow_error) {
+					FixedInteger x = *this;
+					++(*this);
+					return x;}
+
+				// -----------
+				// operator --
+				// -----------
+
+				/**
+				* O(LIMBS)
+				* M(1)
+				* @return the decremented FixedInteger *this
+				* @throws std::overflow_error
+				*/
+				constexpr FixedInteger& operator -- () throw (std::overflow_error) {
+					return *this -= FixedInteger(1);}
+
+				/**
+				* O(LIMBS)
+				* M(1)
+				* @return copy of *this
+				* @throws std::overflow_error
+				*/
+				constexpr FixedInteger operator -- (int) throw (std::overflow_error) {
+					FixedInteger x = *this;
+					--(*this);
+					return x;}
+
+				// -----------
+				// operator +=
+				// -----------
+
+				/**
+				* O(LIMBS)
+				* M(1)
+				* @param that the rhs addend
+				* @return lhs as the sum of lhs and rhs addends
+				* @throws std::overflow_error
+				*/
+				constexpr FixedInteger& operator += (const FixedInteger& that) throw (std::overflow_error) {
+					if(this->sign == that.sign){
+						overflow(limbs, add(limbs, that.limbs), "FixedInteger::operator+=()");
+					} else if(compare(limbs, that.limbs) >= 0){
+						subtract(limbs, that.limbs);
+					} else {
+						limb_type x[LIMBS] = {};
+						copy(that.limbs, x);
+						subtract(x, limbs);
+						copy(x, limbs);
+						this->sign = that.sign;
+					}
+					if(isZero()) this->sign = false;
+					return *this;}
+
+				// -----------
+				// operator -=
+				// -----------
+
+				/**
+				* O(LIMBS)
+				* M(1)
+				* @param that the subtrahend
+				* @return lhs as minuend minus subtrahend
+				* @throws std::overflow_error
+				*/
+				constexpr FixedInteger& operator -= (const FixedInteger& that) throw (std::overflow_error) {
+					return *this += -that;}
+
+				// -----------
+				// operator *=
+				// -----------
+
+				/**
+				* O(LIMBS^2)
+				* M(1)
+				* @param that the rhs multiplicand
+				* @return lhs as the product of lhs and rhs
+				* @throws std::overflow_error
+				*/
+				constexpr FixedInteger& operator *= (const FixedInteger& that) throw (std::overflow_error) {
+					limb_type r[LIMBS] = {};
+					bool carried = false;
+					for(std::size_t j=0; j<LIMBS; ++j){
+						wide_type carry = 0;
+						for(std::size_t i=0; i+j<LIMBS; ++i){
+							carry += wide_type(limbs[i]) * that.limbs[j] + r[i+j];
+							r[i+j] = limb_type(carry);
+							carry >>= 32;
+						}
+						//anything that lands above the top limb is an overflow
+						if(carry) carried = true;
+						for(std::size_t i=LIMBS-j; i<LIMBS && !carried; ++i)
+							carried = limbs[i] && that.limbs[j];
+					}
+					overflow(r, carried, "FixedInteger::operator*=()");
+					copy(r, limbs);
+					this->sign = (this->sign != that.sign) && !isZero();
+					return *this;}
+
+				// -----------
+				// operator /=
+				// -----------
+
+				/**
+				* O(LIMBS^2)
+				* M(1)
+				* @param that the denominator
+				* @return lhs as the quotient of lhs divided by rhs
+				* @throws std::invalid_argument
+				*/
+				constexpr FixedInteger& operator /= (const FixedInteger& that) throw (std::invalid_argument) {
+					if(that.isZero())
+						throw std::invalid_argument("FixedInteger::operator/=()");
+					limb_type q[LIMBS] = {};
+					limb_type r[LIMBS] = {};
+					divide(limbs, that.limbs, q, r);
+					copy(q, limbs);
+					this->sign = (this->sign != that.sign) && !isZero();
+					return *this;}
+
+				// -----------
+				// operator %=
+				// -----------
+
+				/**
+				* O(LIMBS^2)
+				* M(1)
+				* @param that the modulus
+				* @return lhs as lhs mod rhs
+				* @throws std::invalid_argument
+				*/
+				constexpr FixedInteger& operator %= (const FixedInteger& that) throw (std::invalid_argument) {
+					if(that.sign || that.isZero()) throw std::invalid_argument("FixedInteger::operator%=()");
+					if(this->sign) throw std::invalid_argument("FixedInteger::operator%=()");
+					limb_type q[LIMBS] = {};
+					limb_type r[LIMBS] = {};
+					divide(limbs, that.limbs, q, r);
+					copy(r, limbs);
+					return *this;}
+
+				// ----
+				// swap
+				// ----
+
+				/**
+				* O(LIMBS)
+				* M(1)
+				* @param that a FixedInteger
+				*/
+				constexpr void swap (FixedInteger& that) {
+					for(std::size_t i=0; i<LIMBS; ++i){
+						const limb_type t = limbs[i];
+						limbs[i] = that.limbs[i];
+						that.limbs[i] = t;
+					}
+					const bool t = sign;
+					sign = that.sign;
+					that.sign = t;}
+			};
+
+			//init the static const ZERO and ONE
+			template < std::size_t Bits, typename Overflow >
+				const FixedInteger<Bits, Overflow> FixedInteger<Bits, Overflow>::ZERO = FixedInteger<Bits, Overflow>(0);
+
+			template < std::size_t Bits, typename Overflow >
+				const FixedInteger<Bits, Overflow> FixedInteger<Bits, Overflow>::ONE = FixedInteger<Bits, Overflow>(1);
+
+			// ---
+			// abs
+			// ---
+
+			/**
+			* O(LIMBS)
+			* M(1)
+			* @param x a FixedInteger
+			* @return the absolute value of x
+			*/
+			template < std::size_t Bits, typename Overflow >
+				constexpr FixedInteger<Bits, Overflow> abs (const FixedInteger<Bits, Overflow>& x) {
+					return (x < FixedInteger<Bits, Overflow>(0)) ? -x : x;}
+
+			// ---
+			// gcd
+			// ---
+
+			/**
+			* O(LIMBS^3) at most LIMBS*32 Euclidean steps of O(LIMBS^2) each
+			* M(1)
+			* @param x a FixedInteger
+			* @param y a FixedInteger
+			* @return the gcd of x and y
+			* @throws std::invalid_argument
+			*/
+			template < std::size_t Bits, typename Overflow >
+				constexpr FixedInteger<Bits, Overflow> gcd (FixedInteger<Bits, Overflow> x, FixedInteger<Bits, Overflow> y) throw (std::invalid_argument) {
+					const FixedInteger<Bits, Overflow> zero(0);
+					if(x == zero && y == zero) throw std::invalid_argument("gcd()");
+					if(x < zero || y < zero) throw std::invalid_argument("gcd()");
+					while(y != zero){
+						x %= y;
+						x.swap(y);
+					}
+					return x;}
+
+			// ---
+			// pow
+			// ---
+
+			/**
+			* O(LIMBS^2 log exp)
+			* M(1)
+			* left to right, so that no intermediate power exceeds the result and checked
+			* FixedIntegers only overflow when the result itself does not fit
+			* @param x the base
+			* @param exp the exponent
+			* @return the base raised to the exponent
+			* @throws std::invalid_argument
+			* @throws std::overflow_error
+			*/
+			template < std::size_t Bits, typename Overflow >
+				constexpr FixedInteger<Bits, Overflow> pow (const FixedInteger<Bits, Overflow>& x, int exp) throw (std::invalid_argument, std::overflow_error) {
+					if(exp < 0) throw std::invalid_argument("pow()");
+					FixedInteger<Bits, Overflow> r(1); //x^0==1
+					unsigned bit = 1;
+					while(bit <= unsigned(exp) / 2) bit <<= 1;
+					for(; exp && bit; bit >>= 1){
+						r *= r;
+						if(unsigned(exp) & bit) r *= x;
+					}
+					return r;}
+
+		} // integer
+	} // prog
+} // alg
+
+#endif // FixedInteger_h
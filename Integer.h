@@ -10,10 +10,19 @@
 // includes
 // --------
 
+#include <algorithm> // copy, fill, max, min, reverse, swap
+#include <atomic>    // atomic
 #include <cassert>   // assert
+#include <cmath>     // log10, pow
+#include <cstdint>   // uint32_t, uint64_t
+#include <cstring>   // memcpy
+#include <functional> // function, hash
+#include <future>    // async, future
 #include <iostream>  // ostream
+#include <iterator>  // advance, distance, iterator_traits
 #include <stdexcept> // invalid_argument, out_of_range
 #include <string>    // string
+#include <thread>    // thread
 #include <vector>    // vector
 
 // ----------
@@ -34,6 +43,17 @@ namespace alg   {
 				// friends
 				// -------
 
+				template <typename U, typename D>
+				friend Integer<U, D> iroot (const Integer<U, D>& x, int k) throw (std::invalid_argument);
+
+				template <typename U, typename D>
+				friend bool is_square (const Integer<U, D>& x);
+
+				template <typename U, typename D>
+				friend bool is_perfect_power (const Integer<U, D>& x);
+
+				friend class Checkpoint;
+
 				/**
 				* O(n) copy must be made
 				* M(n) copy must be made
@@ -139,19 +159,10 @@ namespace alg   {
 					if(!lhs.sign && rhs.sign) return false;
 					if(lhs.sign) {
 						assert(rhs.sign);
-						if(lhs.data.size() > rhs.data.size()) return true;
-						if(lhs.data.size() < rhs.data.size()) return false;
-
-						assert(lhs.data.size() == rhs.data.size());
-						return lhs.data > rhs.data;  //invoke Container's lexigraphical compare
+						return compareMagnitude(lhs.data, rhs.data) > 0;
 					} else {
 						assert(!rhs.sign);
-						if(lhs.data.size() < rhs.data.size()) return true;
-						if(lhs.data.size() > rhs.data.size()) return false;
-
-						assert(lhs.data.size() == rhs.data.size());
-
-						return lhs.data < rhs.data;  //invoke Container's lexigraphical compare
+						return compareMagnitude(lhs.data, rhs.data) < 0;
 					}
 				}
 
@@ -194,10 +205,54 @@ namespace alg   {
 				*/
 				friend std::ostream& operator << (std::ostream& lhs, const Integer& rhs) {
 					if(rhs.sign) lhs << "-";
-					for(const_iterator i = rhs.data.begin(); i<rhs.data.end(); ++i)
+					for(const_iterator i = rhs.begin(); i != rhs.end(); ++i)
 						lhs << *i;
 					return lhs;}
 
+				/**
+				* O(n)
+				* M(n)
+				* skips leading whitespace then reads an optional - and every digit that follows,
+				* setting failbit and leaving rhs unchanged if there are none
+				* @param lhs an istream
+				* @param rhs an Integer
+				* @return the istream
+				*/
+				friend std::istream& operator >> (std::istream& lhs, Integer& rhs) {
+					typedef std::istream::traits_type traits_type;
+					std::istream::sentry ok(lhs);
+					if(!ok) return lhs;
+
+					Parser p;
+					char chunk[4096];
+					std::size_t n = 0;
+					std::streambuf* in = lhs.rdbuf();
+					traits_type::int_type c = in->sgetc();
+					if(traits_type::eq_int_type(c, traits_type::to_int_type('-'))){
+						chunk[n++] = '-';
+						c = in->snextc();
+					}
+					while(!traits_type::eq_int_type(c, traits_type::eof()) && isDigit(traits_type::to_char_type(c))){
+						chunk[n++] = traits_type::to_char_type(c);
+						if(n == sizeof chunk){
+							p.feed(chunk, chunk+n);
+							n = 0;
+						}
+						c = in->snextc();
+					}
+					if(traits_type::eq_int_type(c, traits_type::eof()))
+						lhs.setstate(std::ios_base::eofbit);
+					p.feed(chunk, chunk+n);
+
+					try{
+						Integer r = p.finish();
+						rhs.swap(r);
+					}
+					catch(std::invalid_argument &e){
+						lhs.setstate(std::ios_base::failbit);
+					}
+					return lhs;}
+
 			public:
 				// --------
 				// typedefs
@@ -212,8 +267,10 @@ namespace alg   {
 				typedef typename container_type::reference       reference;
 				typedef typename container_type::const_reference const_reference;
 
-				typedef typename container_type::iterator        iterator;
-				typedef typename container_type::const_iterator  const_iterator;
+				//the container holds the least significant digit first, so that carries and
+				//normalisation happen at its end, while iteration runs from the most significant
+				typedef std::reverse_iterator<typename container_type::iterator>       iterator;
+				typedef std::reverse_iterator<typename container_type::const_iterator> const_iterator;
 
 				static const Integer ZERO;
 				static const Integer ONE;
@@ -224,6 +281,73 @@ namespace alg   {
 				container_type data;
 				bool sign;
 
+#ifdef INTEGER_CACHE_HASH
+				/**
+				* the value of hash(), or 0 until it has been asked for since the last change.  Relaxed
+				* atomics let any number of threads hash one const Integer, as they all store the same value.
+				*/
+				struct HashCache {
+					mutable std::atomic<std::size_t> value;
+
+					//true once a non-const operator [], at, begin or end has handed out a way to write the
+					//digits, which may be used at any later time, so from then on hash() is not cached.
+					//It stays with the digits: a copy has digits of its own, a move or swap takes them along.
+					bool writable;
+
+					HashCache () : value(0), writable(false) {}
+
+					HashCache (const HashCache& that) : value(that.value.load(std::memory_order_relaxed)), writable(false) {}
+
+					HashCache (HashCache&& that) : value(that.value.load(std::memory_order_relaxed)), writable(that.writable) {}
+
+					//the digits are copied into whatever storage *this already has, which keeps any handles to it
+					HashCache& operator = (const HashCache& that) {
+						value.store(that.value.load(std::memory_order_relaxed), std::memory_order_relaxed);
+						return *this;}
+
+					HashCache& operator = (HashCache&& that) {
+						value.store(that.value.load(std::memory_order_relaxed), std::memory_order_relaxed);
+						writable = that.writable;
+						return *this;}
+
+					void swap (HashCache& that) {
+						const std::size_t v = value.load(std::memory_order_relaxed);
+						value.store(that.value.load(std::memory_order_relaxed), std::memory_order_relaxed);
+						that.value.store(v, std::memory_order_relaxed);
+						std::swap(writable, that.writable);}
+				};
+
+				HashCache hashed;
+#endif
+
+				// -------
+				// changed
+				// -------
+
+				/**
+				* O(1)
+				* M(1)
+				* must be called by everything that changes the value of *this, to drop a cached hash
+				*/
+				void changed () {
+#ifdef INTEGER_CACHE_HASH
+					hashed.value.store(0, std::memory_order_relaxed);
+#endif
+				}
+
+				/**
+				* O(1)
+				* M(1)
+				* must be called by everything that hands out a reference or iterator through which the digits can be
+				* changed later, as the change cannot be seen when it is made
+				*/
+				void exposed () {
+					changed();
+#ifdef INTEGER_CACHE_HASH
+					hashed.writable = true;
+#endif
+				}
+
 				// -------
 				// isDigit
 				// -------
@@ -236,6 +360,37 @@ namespace alg   {
 				*/
 				static inline bool isDigit(char c){ c-='0'; return c >= 0 && c <= 9; }
 
+				/**
+				* O(1)
+				* M(1)
+				* tests a whole 64 bit word at a time: every byte of a digit has a high nibble of 3,
+				* and still does after adding 6, which would carry any of ':' through '?' out of it
+				* @param p points to eight characters
+				* @return true if all eight characters are digits
+				*/
+				static inline bool areDigits(const char* p){
+					const std::uint64_t nibbles = 0xF0F0F0F0F0F0F0F0ull;
+					const std::uint64_t threes  = 0x3030303030303030ull;
+					std::uint64_t w = 0;
+					std::memcpy(&w, p, sizeof w);
+					return (w & nibbles) == threes && ((w + 0x0606060606060606ull) & nibbles) == threes;}
+
+				// -------
+				// reserve
+				// -------
+
+				/**
+				* O(n)
+				* M(n)
+				* reserves room for n digits in containers that support it, and does nothing for the rest
+				*/
+				template <typename D>
+				static auto reserve (D& d, size_type n, int) -> decltype(d.reserve(n), void()) {
+					d.reserve(n);}
+
+				template <typename D>
+				static void reserve (D&, size_type, long) {}
+
 				// -----
 				// valid
 				// -----
@@ -248,6 +403,501 @@ namespace alg   {
 				bool valid () const {
 					return data.size() > 0;}
 
+				// ------
+				// isZero
+				// ------
+
+				/**
+				* O(1)
+				* M(1)
+				* @return true if *this is zero
+				*/
+				bool isZero () const {
+					return data.size() == 1 && 0 == *data.begin();}
+
+				// -----
+				// shift
+				// -----
+
+				/**
+				* O(n+k)
+				* M(k)
+				* multiplies *this by 10^k
+				* @param k the number of zeros to append
+				* @return *this
+				*/
+				Integer& shiftLeft (size_type k) {
+					changed();
+					if(!isZero()) data.insert(data.begin(), k, 0);
+					return *this;}
+
+				/**
+				* O(n)
+				* M(1)
+				* divides *this by 10^k, truncating toward zero
+				* @param k the number of least significant digits to drop
+				* @return *this
+				*/
+				Integer& shiftRight (size_type k) {
+					changed();
+					if(k >= data.size()){
+						data.assign(1, 0);
+						sign = false;
+					} else {
+						data.erase(data.begin(), data.begin()+k);
+					}
+					return *this;}
+
+				// ----
+				// trim
+				// ----
+
+				/**
+				* O(z) where z is the number of leading zeros
+				* M(1)
+				* gets rid of leading zeros, which sit at the end of the container
+				* @param d the digits of a magnitude
+				*/
+				static void trim (container_type& d) {
+					while(d.size() > 1 && 0 == d.back())
+						d.pop_back();}
+
+				// -----------
+				// small words
+				// -----------
+
+				/**
+				* O(n)
+				* M(1)
+				* divides the magnitude of *this by d in a single pass, truncating toward zero
+				* @param d a positive divisor, small enough that 10*d fits in an unsigned long long
+				* @return the remainder of the magnitude of *this divided by d
+				*/
+				unsigned long long divideSmall (unsigned long long d) {
+					assert(d > 0);
+					changed();
+					unsigned long long rem = 0;
+					for(typename container_type::reverse_iterator i = data.rbegin(); i != data.rend(); ++i){
+						rem = rem*10 + *i;
+						*i = static_cast<value_type>(rem / d);
+						rem %= d;
+					}
+					trim(data);
+
+					//turn -0 into 0 if necessary
+					if(isZero()) sign = false;
+					return rem;}
+
+				/**
+				* O(n)
+				* M(1)
+				* @param d a positive divisor, small enough that 10*d fits in an unsigned long long
+				* @return the remainder of the magnitude of *this divided by d
+				*/
+				unsigned long long moduloSmall (unsigned long long d) const {
+					assert(d > 0);
+					unsigned long long rem = 0;
+					for(typename container_type::const_reverse_iterator i = data.rbegin(); i != data.rend(); ++i)
+						rem = (rem*10 + *i) % d;
+					return rem;}
+
+				/**
+				* O(log w)
+				* M(log w)
+				* @param w a non-negative number
+				* @return w as an Integer
+				*/
+				static Integer fromWide (unsigned long long w) {
+					Integer r(0);
+					r.data.clear();
+					do{
+						r.data.push_back(static_cast<value_type>(w%10));
+						w/=10;
+					}while(w);
+					return r;}
+
+				/**
+				* O(n)
+				* M(1)
+				* @return the magnitude of *this, which must have no more than 19 digits
+				*/
+				unsigned long long toWide () const {
+					assert(data.size() <= 19);
+					unsigned long long w = 0;
+					for(typename container_type::const_reverse_iterator i = data.rbegin(); i != data.rend(); ++i)
+						w = w*10 + *i;
+					return w;}
+
+				// -----
+				// limbs
+				// -----
+
+				/**
+				* O(L)
+				* M(1)
+				* @param limbs a magnitude in 32 bit limbs, least significant first, which is divided by d
+				* and left without leading zero limbs
+				* @param d a positive divisor
+				* @return the remainder
+				*/
+				static std::uint32_t divideLimbs (std::vector<std::uint32_t>& limbs, std::uint32_t d) {
+					std::uint64_t rem = 0;
+					for(std::size_t i = limbs.size(); i--; ){
+						const std::uint64_t cur = (rem << 32) | limbs[i];
+						limbs[i] = std::uint32_t(cur / d);
+						rem = cur % d;
+					}
+					while(limbs.size() > 1 && !limbs.back()) limbs.pop_back();
+					return std::uint32_t(rem);}
+
+				/**
+				* O(1)
+				* M(1)
+				* @return the value of c as a digit, with the letters in either case past 9, or 36 if it is none
+				*/
+				static int digitValue (char c) {
+					if(isDigit(c)) return c - '0';
+					if('a' <= c && c <= 'z') return c - 'a' + 10;
+					if('A' <= c && c <= 'Z') return c - 'A' + 10;
+					return 36;}
+
+				// ----------
+				// magnitudes
+				// ----------
+
+				/**
+				* O(n)
+				* M(1)
+				* a and b are least significant digit first without leading zeros
+				* @return negative, zero or positive as the magnitude a is less than, equal to, or greater than b
+				*/
+				static int compareMagnitude (const container_type& a, const container_type& b) {
+					if(a.size() != b.size()) return a.size() < b.size() ? -1 : 1;
+					typename container_type::const_reverse_iterator x = a.rbegin();
+					typename container_type::const_reverse_iterator y = b.rbegin();
+					while(x != a.rend() && *x == *y){
+						++x;
+						++y;
+					}
+					return (x == a.rend()) ? 0 : (*x < *y ? -1 : 1);}
+
+				/**
+				* O(m) plus however far the carry runs
+				* M(1) or M(m-n) depending on if a is at least as long as b or not
+				* a += b for magnitudes, least significant digit first
+				*/
+				static void addMagnitude (container_type& a, const container_type& b) {
+					if(a.size() < b.size()) a.resize(b.size(), 0);
+					typename container_type::iterator top = a.begin();
+					value_type carry = 0;
+					for(typename container_type::const_iterator bottom = b.begin(); bottom != b.end(); ++bottom, ++top){
+						value_type sum = (*top+*bottom)+carry;
+						carry = sum >= 10;
+						*top = carry ? sum - 10 : sum;
+					}
+					for(; carry && top != a.end(); ++top){
+						carry = 9 == *top;
+						*top = carry ? 0 : *top + 1;
+					}
+					if(carry) a.push_back(carry);}
+
+				/**
+				* O(m) plus however far the borrow runs
+				* M(1)
+				* a -= b for magnitudes where a >= b, least significant digit first,
+				* leaving a without leading zeros
+				*/
+				static void subtractMagnitude (container_type& a, const container_type& b) {
+					assert(compareMagnitude(a, b) >= 0);
+					typename container_type::iterator top = a.begin();
+					int borrow = 0;
+					for(typename container_type::const_iterator bottom = b.begin(); bottom != b.end(); ++bottom, ++top){
+						const int diff = int(*top) - int(*bottom) - borrow;
+						borrow = diff < 0;
+						*top = static_cast<value_type>(borrow ? diff + 10 : diff);
+					}
+					for(; borrow; ++top){
+						borrow = 0 == *top;
+						*top = borrow ? 9 : *top - 1;
+					}
+					trim(a);}
+
+				/**
+				* O(m)
+				* M(m-n)
+				* a = b - a for magnitudes where b >= a, least significant digit first,
+				* leaving a without leading zeros
+				*/
+				static void subtractFromMagnitude (container_type& a, const container_type& b) {
+					assert(compareMagnitude(a, b) <= 0);
+					a.resize(b.size(), 0);
+					typename container_type::iterator top = a.begin();
+					int borrow = 0;
+					for(typename container_type::const_iterator bottom = b.begin(); bottom != b.end(); ++bottom, ++top){
+						const int diff = int(*bottom) - int(*top) - borrow;
+						borrow = diff < 0;
+						*top = static_cast<value_type>(borrow ? diff + 10 : diff);
+					}
+					assert(!borrow);
+					trim(a);}
+
+				// --------
+				// division
+				// --------
+
+				/**
+				* divisors of at most this many digits are divided out a word at a time
+				*/
+				enum { SHORT_DIVISOR = 17 };
+
+				/**
+				* O(n) if d has at most SHORT_DIVISOR digits, otherwise O(n*m)
+				* M(n+m)
+				* schoolbook long division of magnitudes, least significant digit first.  Only reads
+				* its operands, so the divisor can be shared between threads without locking.
+				* @param n the dividend
+				* @param d the divisor, which must not be zero
+				* @param q receives n / d
+				* @param r receives n % d
+				* @param step if not null, called with 256 after every 256 digits of n, and may throw to abandon the division
+				*/
+				static void divide (const container_type& n, const container_type& d, container_type& q, container_type& r,
+				                    const std::function<void (size_type)>* step = 0) {
+					q.clear();
+					r.clear();
+					if(compareMagnitude(n, d) < 0){
+						q.push_back(0);
+						r = n;
+						return;
+					}
+
+					//a divisor of at most SHORT_DIVISOR digits fits in one word, and n is divided by it in a single pass
+					if(d.size() <= SHORT_DIVISOR){
+						unsigned long long w = 0;
+						for(typename container_type::const_reverse_iterator y = d.rbegin(); y != d.rend(); ++y)
+							w = w*10 + *y;
+						q.resize(n.size(), 0);
+						typename container_type::iterator z = q.end();
+						unsigned long long rem = 0;
+						for(typename container_type::const_reverse_iterator x = n.rbegin(); x != n.rend(); ++x){
+							rem = rem*10 + *x;
+							*--z = static_cast<value_type>(rem / w);
+							rem %= w;
+							const size_type done = static_cast<size_type>(x - n.rbegin()) + 1;
+							if(step && !(done % 256))
+								(*step)(256);
+						}
+						trim(q);
+						do{
+							r.push_back(static_cast<value_type>(rem % 10));
+							rem /= 10;
+						}while(rem);
+						return;
+					}
+
+					//the multiples d, 2d, ..., 9d against which each quotient digit is chosen
+					std::vector<container_type> multiples(10);
+					multiples[1] = d;
+					for(int t=2; t<10; ++t){
+						multiples[t] = multiples[t-1];
+						addMagnitude(multiples[t], d);
+					}
+
+					//      zz
+					//   -----
+					//yyy|xxxx
+					q.resize(n.size() - d.size() + 1, 0);
+					typename container_type::iterator z = q.end();
+					reserve(r, d.size() + 1, 0);
+					for(typename container_type::const_reverse_iterator x = n.rbegin(); x != n.rend(); ++x){
+						//bring down the next digit, never leaving a leading zero
+						if(r.size() == 1 && 0 == r.front())
+							r.front() = *x;
+						else
+							r.insert(r.begin(), *x);
+
+						//binary search for the largest t with t*d <= r
+						int lo = 0;
+						int hi = 9;
+						while(lo < hi){
+							const int t = (lo + hi + 1) / 2;
+							if(compareMagnitude(multiples[t], r) <= 0) lo = t;
+							else hi = t - 1;
+						}
+						if(lo) subtractMagnitude(r, multiples[lo]);
+
+						//the first d.size()-1 digits brought down can never give a quotient digit
+						const size_type done = static_cast<size_type>(x - n.rbegin()) + 1;
+						if(z != q.begin() && done >= d.size())
+							*--z = lo;
+						if(step && !(done % 256))
+							(*step)(256);
+					}
+					assert(z == q.begin());
+					trim(q);}
+
+				// ---------
+				// karatsuba
+				// ---------
+
+				/**
+				* operands shorter than this many digits are multiplied by the schoolbook method
+				*/
+				enum { KARATSUBA_THRESHOLD = 48 };
+
+				/**
+				* O(n*m)
+				* M(1)
+				* a, b and r are least significant digit first
+				* @param a the digits of the first multiplicand
+				* @param n the number of digits in a
+				* @param b the digits of the second multiplicand
+				* @param m the number of digits in b
+				* @param r receives the n+m digits of the product
+				*/
+				static void mulSchool (const unsigned* a, size_type n, const unsigned* b, size_type m, unsigned* r) {
+					std::fill(r, r+n+m, 0u);
+					for(size_type j=0; j<m; ++j){
+						if(b[j]){
+							unsigned carry = 0;
+							for(size_type i=0; i<n; ++i){
+								unsigned prod = a[i] * b[j] + r[i+j] + carry;
+								r[i+j] = prod % 10;
+								carry = prod / 10;
+							}
+							r[j+n] = carry;
+						}
+					}}
+
+				/**
+				* O(n)
+				* M(1)
+				* adds the n digits of b into the m digits of a, propagating the carry through a
+				* @return the carry out of the most significant digit of a
+				*/
+				static unsigned addDigits (unsigned* a, size_type m, const unsigned* b, size_type n) {
+					assert(n <= m);
+					unsigned carry = 0;
+					size_type i = 0;
+					for(; i<n; ++i){
+						unsigned sum = a[i] + b[i] + carry;
+						carry = sum >= 10;
+						a[i] = carry ? sum - 10 : sum;
+					}
+					for(; carry && i<m; ++i){
+						carry = a[i] == 9;
+						a[i] = carry ? 0 : a[i] + 1;
+					}
+					return carry;}
+
+				/**
+				* O(n)
+				* M(1)
+				* subtracts the n digits of b from the m digits of a, where a >= b
+				*/
+				static void subDigits (unsigned* a, size_type m, const unsigned* b, size_type n) {
+					assert(n <= m);
+					unsigned borrow = 0;
+					size_type i = 0;
+					for(; i<n; ++i){
+						unsigned sub = b[i] + borrow;
+						borrow = a[i] < sub;
+						a[i] = borrow ? a[i] + 10 - sub : a[i] - sub;
+					}
+					for(; borrow && i<m; ++i){
+						borrow = a[i] == 0;
+						a[i] = borrow ? 9 : a[i] - 1;
+					}
+					assert(!borrow);}
+
+				/**
+				* O(1)
+				* M(1)
+				* @param n the length of both karatsuba operands
+				* @return the number of scratch digits mulKaratsuba needs for operands of length n
+				*/
+				static size_type karatsubaScratch (size_type n) {
+					size_type r = 0;
+					while(n >= KARATSUBA_THRESHOLD){
+						n = n - n/2 + 1;
+						r += 4*n;
+					}
+					return r;}
+
+				/**
+				* O(n^1.585)
+				* M(1) all temporaries are carved out of w
+				* a, b and r are least significant digit first
+				* @param a the digits of the first multiplicand
+				* @param b the digits of the second multiplicand
+				* @param n the number of digits in both a and b
+				* @param r receives the 2n digits of the product
+				* @param w scratch space of at least karatsubaScratch(n) digits
+				*/
+				static void mulKaratsuba (const unsigned* a, const unsigned* b, size_type n, unsigned* r, unsigned* w) {
+					if(n < KARATSUBA_THRESHOLD){
+						mulSchool(a, n, b, n, r);
+						return;
+					}
+
+					//a = a1*10^h + a0, b = b1*10^h + b0
+					const size_type h = n/2;
+					const size_type k = n-h;
+
+					//r = a1*b1*10^2h + a0*b0
+					mulKaratsuba(a, b, h, r, w);
+					mulKaratsuba(a+h, b+h, k, r+2*h, w);
+
+					//z = (a0+a1)*(b0+b1) - a0*b0 - a1*b1 = a0*b1 + a1*b0
+					unsigned* sa = w;
+					unsigned* sb = sa + k+1;
+					unsigned* z  = sb + k+1;
+					std::copy(a+h, a+n, sa);
+					sa[k] = addDigits(sa, k, a, h);
+					std::copy(b+h, b+n, sb);
+					sb[k] = addDigits(sb, k, b, h);
+					mulKaratsuba(sa, sb, k+1, z, z + 2*(k+1));
+					subDigits(z, 2*(k+1), r, 2*h);
+					subDigits(z, 2*(k+1), r+2*h, 2*k);
+
+					//r += z*10^h
+					unsigned carry = addDigits(r+h, 2*n-h, z, 2*(k+1));
+					assert(!carry);}
+
+				/**
+				* O(n*m^0.585) where m <= n
+				* M(n+m)
+				* a, b and r are least significant digit first
+				* @param a the digits of the first multiplicand
+				* @param n the number of digits in a
+				* @param b the digits of the second multiplicand
+				* @param m the number of digits in b
+				* @param r receives the n+m digits of the product
+				*/
+				static void mulDigits (const unsigned* a, size_type n, const unsigned* b, size_type m, unsigned* r) {
+					if(n < m){
+						std::swap(a, b);
+						std::swap(n, m);
+					}
+					if(m < KARATSUBA_THRESHOLD){
+						mulSchool(a, n, b, m, r);
+						return;
+					}
+
+					//multiply b by m digit slices of a, each slice being a balanced product
+					std::vector<unsigned> slice(2*m);
+					std::vector<unsigned> w(karatsubaScratch(m));
+					std::fill(r, r+n+m, 0u);
+					for(size_type offset=0; offset<n; offset+=m){
+						const size_type length = (n-offset < m) ? n-offset : m;
+						if(length == m)
+							mulKaratsuba(a+offset, b, m, &slice[0], w.empty() ? 0 : &w[0]);
+						else
+							mulDigits(b, m, a+offset, length, &slice[0]);
+						unsigned carry = addDigits(r+offset, n+m-offset, &slice[0], m+length);
+						assert(!carry);
+					}}
+
 			public:
 				// ------------
 				// constructors
@@ -261,13 +911,13 @@ namespace alg   {
 				Integer (int i) {
 					if(i<0){
 						do{
-							data.insert(data.begin(), -(i%10));
+							data.push_back(-(i%10));
 							i/=10;
 						}while(i);
 						sign=true;
 					} else {
 						do{
-							data.insert(data.begin(), i%10);
+							data.push_back(i%10);
 							i/=10;
 						}while(i);
 						sign=false;
@@ -281,42 +931,216 @@ namespace alg   {
 				* @param s the string representation of a positive or negative number in base 10
 				* @throws std::invalid_argument
 				*/
-				explicit Integer (const std::string& s) throw (std::invalid_argument) {
-					sign = false;
-					std::string::const_iterator i=s.begin();
-					//see if first character is - and handle accordingly
-					if('-'==*i){
-						++i;
-						if(s.end() == i) //handles the case if user passes in just a "-"
-							throw std::invalid_argument("Integer::Integer()");
+				explicit Integer (const std::string& s) throw (std::invalid_argument) : sign(false) {
+					Parser p(s.size());
+					p.feed(s.data(), s.data() + s.size());
+					Integer r = p.finish();
+					swap(r);
+					assert(valid());
+				}
 
-						sign = true;
+				/**
+				* O(n) in base 10, otherwise O(n) to reach binary for power of two bases and O(n^2) word operations,
+				* a few digits at a time, for the rest, then O(n^2) word operations to reach base 10
+				* M(n)
+				* @param s the representation of a positive or negative number, with digits past 9 taken from
+				* the letters in either case
+				* @param base the radix of s, from 2 to 36
+				* @return the number s represents
+				* @throws std::invalid_argument
+				*/
+				static Integer from_string (const std::string& s, int base = 10) throw (std::invalid_argument) {
+					if(base < 2 || base > 36) throw std::invalid_argument("Integer::from_string()");
+					if(base == 10) return Integer(s);
+
+					const std::size_t first = !s.empty() && '-' == s[0];
+					if(first == s.size()) // "" and "-" are NOT valid integers
+						throw std::invalid_argument("Integer::from_string()");
+
+					std::vector<std::uint32_t> limbs(1, 0);
+					int bits = 0;
+					while((1 << bits) < base) ++bits;
+					if(1 << bits == base){
+						//lay each digit's bits straight into the limbs, from the least significant up
+						limbs.assign(((s.size() - first)*bits + 31)/32, 0);
+						std::size_t at = 0;
+						for(std::size_t i = s.size(); i-- > first; at += bits){
+							const std::uint64_t d = digitValue(s[i]);
+							if(d >= std::uint64_t(base)) throw std::invalid_argument("Integer::from_string()");
+							limbs[at/32] |= std::uint32_t(d << (at%32));
+							if(at%32 + bits > 32) limbs[at/32 + 1] |= std::uint32_t(d >> (32 - at%32));
+						}
+						while(limbs.size() > 1 && !limbs.back()) limbs.pop_back();
+					} else {
+						//multiply in as many digits at a time as the largest power of base that fits in a limb
+						std::size_t k = 1;
+						while(std::pow(double(base), double(k+1)) <= 4294967295.0) ++k;
+						for(std::size_t i = first; i < s.size(); ){
+							std::uint64_t scale = 1;
+							std::uint64_t carry = 0;
+							for(std::size_t n = std::min(k, s.size() - i); n; --n, ++i){
+								const int d = digitValue(s[i]);
+								if(d >= base) throw std::invalid_argument("Integer::from_string()");
+								carry = carry*base + d;
+								scale *= base;
+							}
+							for(std::size_t j=0; j<limbs.size(); ++j){
+								const std::uint64_t t = std::uint64_t(limbs[j])*scale + carry;
+								limbs[j] = std::uint32_t(t);
+								carry = t >> 32;
+							}
+							if(carry) limbs.push_back(std::uint32_t(carry));
+						}
 					}
 
-					for(;('0'==*i) && (i < s.end()-1); ++i) {} //scoot past leading zeros if there are any
+					Integer r = from_limbs(limbs);
+					r.sign = first && !r.isZero();
+					return r;}
 
-					if(i == s.end()-1 && *i == '0') sign = false; //eliminate negative zero
+				// ----------
+				// from_limbs
+				// ----------
 
-					for(;i<s.end(); ++i){
-						if(!isDigit(*i)){
-							data.clear();   //all data thus far is deemed garbage if a non-digit is encountered
-							data.push_back(0);
-							throw std::invalid_argument("Integer::Integer()");
-						}
-						data.push_back(*i-'0');
+				/**
+				* O(n^2) word operations, a ninth of them per digit as nine digits are produced at a time
+				* M(n)
+				* @param limbs a magnitude in 32 bit limbs, least significant first
+				* @return the magnitude as a non-negative Integer
+				*/
+				static Integer from_limbs (std::vector<std::uint32_t> limbs) {
+					Integer r(0);
+					r.data.clear();
+					reserve(r.data, 10*limbs.size(), 0);
+					while(limbs.size() > 1 || limbs[0]){
+						std::uint32_t rem = divideLimbs(limbs, 1000000000u);
+						for(int j=0; j<9; ++j, rem /= 10)
+							r.data.push_back(rem % 10);
 					}
+					if(r.data.empty()) r.data.push_back(0);
+					trim(r.data);
+					return r;}
 
-					if(data.size() == 0) // empty string is NOT valid integer
-						throw std::invalid_argument("Integer::Integer()");
+				// -----------
+				// from_digits
+				// -----------
 
-					assert(valid());
-				}
+				/**
+				* O(n)
+				* M(n)
+				* @param first an iterator to the least significant digit
+				* @param last an iterator one past the most significant digit
+				* @return the non-negative Integer with those digits, or ZERO if there are none; leading zeros are dropped
+				* @throws std::invalid_argument if a digit is not from 0 to 9
+				*/
+				template <typename II>
+				static Integer from_digits (II first, II last) throw (std::invalid_argument) {
+					Integer r(0);
+					r.data.assign(first, last);
+					const container_type& d = r.data;
+					for(typename container_type::const_iterator i = d.begin(); i != d.end(); ++i){
+						if(*i < 0 || *i > 9) throw std::invalid_argument("Integer::from_digits()");
+					}
+					if(r.data.empty()) r.data.push_back(0);
+					trim(r.data);
+					return r;}
 
 				// Default copy, destructor, and copy assignment.
 				// Integer (const Integer&);
 				// ~Integer ();
 				// Integer& operator = (const Integer&);
 
+				// ------
+				// Parser
+				// ------
+
+				/**
+				* builds an Integer from base 10 text handed over in chunks of any size, so that
+				* input never has to be held in memory as a whole alongside the Integer's digits.
+				* A Parser that has thrown must not be fed again.
+				*/
+				class Parser {
+				public:
+					/**
+					* O(1) or O(hint) depending on if the container can reserve
+					* M(hint)
+					* @param hint the expected number of characters, 0 if unknown
+					*/
+					explicit Parser (size_type hint = 0) : sign(false), started(false), digits(false) {
+						reserve(data, hint, 0);}
+
+					/**
+					* O(n)
+					* M(n)
+					* @param first the first character of the next chunk
+					* @param last one past the last character of the next chunk
+					* @throws std::invalid_argument
+					*/
+					void feed (const char* first, const char* last) throw (std::invalid_argument) {
+						if(first == last) return;
+						//see if first character of the whole number is - and handle accordingly
+						if(!started){
+							started = true;
+							if('-'==*first){
+								sign = true;
+								++first;
+							}
+						}
+
+						//check the chunk eight characters at a time before touching the container
+						const char* i = first;
+						for(; last-i >= 8; i+=8){
+							if(!areDigits(i)) fail();
+						}
+						for(; i<last; ++i){
+							if(!isDigit(*i)) fail();
+						}
+						if(first < last) digits = true;
+
+						//scoot past leading zeros if there are any
+						if(data.empty()){
+							while(first < last && '0'==*first) ++first;
+						}
+						for(; first<last; ++first)
+							data.push_back(*first-'0');
+					}
+
+					/**
+					* O(n)
+					* M(1)
+					* @return the Integer fed so far, leaving the Parser ready to start a new one
+					* @throws std::invalid_argument
+					*/
+					Integer finish () throw (std::invalid_argument) {
+						if(!digits) // "" and "-" are NOT valid integers
+							fail();
+						Integer r(0);
+						if(!data.empty()){
+							//digits arrive most significant first
+							std::reverse(data.begin(), data.end());
+							r.data.swap(data);
+							r.sign = sign;  //an empty container means the digits were all zeros, eliminating negative zero
+						}
+						data.clear();
+						sign = started = digits = false;
+						assert(r.valid());
+						return r;}
+
+				private:
+					container_type data;
+					bool sign;
+					bool started;  //true once the optional - has been looked for
+					bool digits;   //true once any digit has been fed
+
+					/**
+					* all data thus far is deemed garbage if a non-digit is encountered
+					* @throws std::invalid_argument
+					*/
+					void fail () throw (std::invalid_argument) {
+						data.clear();
+						sign = started = digits = false;
+						throw std::invalid_argument("Integer::Parser()");}
+				};
+
 				// -----------
 				// operator []
 				// -----------
@@ -328,16 +1152,17 @@ namespace alg   {
 				* @return value at specified index from right
 				*/
 				reference operator [] (size_type index) {
-					return data[data.size()-index-1];}
+					exposed();
+					return data[index];}
 
 				/**
 				* O(1) if underlying container has const time indexing operator
 				* M(1)
 				* @param index
-				* @return value at specified index
+				* @return value at specified index from right
 				*/
 				const_reference operator [] (size_type index) const {
-					return const_cast<Integer*>(this)->operator[](index);}
+					return data[index];}
 
 				// -----------
 				// operator ++
@@ -400,102 +1225,20 @@ namespace alg   {
 				* @return lhs as the sum of lhs and rhs addends
 				*/
 				Integer& operator += (const Integer& that) {
-
-					bool bottomIsBigger;  //holds true if |y|>|x| in x-y.
-					//Only matters when signs differ between the two addends
-					if(this->sign != that.sign){
-						if(that.sign) {
-							this->sign = true;
-							bottomIsBigger = (that < *this);
-							this->sign = false;
-						} else {
-							this->sign = false;
-							bottomIsBigger = (*this < that);
-							this->sign = true;
-						}
-					}
-
-					//MUST use a signed type.  size_type can not guarantee this.
-					int offset = that.data.size()-(this->data.size());
-
-					//make lhs the same size as the rhs if |lhs| < |rhs|
-					if(offset < 0) offset = 0;
-					this->data.insert(this->data.begin(), offset, 0);
-
-					assert(that.data.size() <= this->data.size());
-
-					iterator top = this->data.end()-1;
-					const_iterator bottom = that.data.end()-1;
-					value_type carry = 0;
-
-					//handle both cases separately for speed
+					changed();
 					//+top +bottom or -top -bottom
 					if(this->sign == that.sign){
-						while(bottom >= that.data.begin()){
-							value_type sum = (*top+*bottom)+carry;
-							carry = sum / 10;
-							sum %= 10;
-							*top = sum;
-							--top;
-							--bottom;
-						}
-						while(top >= this->data.begin()){
-							value_type sum = *top+carry;
-							carry = sum / 10;
-							sum %= 10;
-							*top = sum;
-							--top;
-						}
-						if(carry) this->data.insert(this->data.begin(), carry);
-					} else { //-top +bottom or +top -bottom
-						//compute top - bottom in base 10
-						carry = 1;
-						while(bottom >= that.data.begin()){
-							//1. Add top to the 10's complement of bottom.
-							value_type sum = (*top+(9-*bottom))+carry;
-							carry = sum / 10;
-							sum %= 10;
-							*top = sum;
-							--top;
-							--bottom;
-						}
-						while(top >= this->data.begin()){
-							value_type sum = *top+9+carry;
-							carry = sum / 10;
-							sum %= 10;
-							*top = sum;
-							--top;
-						}
-						//2. If there is a carry, discard it. What is left is the result top - bottom.
-						//3. If there is no carry, take the 10's complement of the sum
-						if(!carry) {
-							carry = 1;
-							top = this->data.end()-1;
-							while(top >= this->data.begin()){
-								value_type sum = 9-*top+carry;
-								carry = sum / 10;
-								sum %= 10;
-								*top = sum;
-								--top;
-							}
-						}
-
-						if(bottomIsBigger) this->sign = !this->sign;
-
-						//get rid of leading zeros
-						top = this->data.begin();
-						if(0==*top){
-							while(0==*top && top < this->data.end()-1){
-								++top;
-							}
-							this->data.erase(this->data.begin(), top);
-
-							//turn -0 into 0 if necessary
-							if(this->data.size()==1 && this->data[0]==0)
-								this->sign = false;
-						}
+						addMagnitude(this->data, that.data);
+					} else if(compareMagnitude(this->data, that.data) >= 0){ //-top +bottom or +top -bottom
+						subtractMagnitude(this->data, that.data);
+					} else { //the bottom is bigger, so it decides the sign
+						subtractFromMagnitude(this->data, that.data);
+						this->sign = that.sign;
 					}
 
+					//turn -0 into 0 if necessary
+					if(isZero()) this->sign = false;
+
 					assert(valid());
 					return *this;}
 
@@ -510,98 +1253,20 @@ namespace alg   {
 				* @return lhs as minuend minus subtrahend
 				*/
 				Integer& operator -= (const Integer& that) {
-
-					bool bottomIsBigger;  //holds true if |y|>|x| in x-y.
-					//Only matters when signs same between the minuend and subtrahend
-					if(this->sign == that.sign){
-						if(that.sign) {
-							bottomIsBigger = (that < *this);
-						} else {
-							bottomIsBigger = (*this < that);
-						}
-					}
-
-					//MUST use a signed type.  size_type can not guarantee this.
-					int offset = that.data.size()-(this->data.size());
-
-					//make lhs the same size as the rhs if |lhs| < |rhs|
-					if(offset < 0) offset = 0;
-					this->data.insert(this->data.begin(), offset, 0);
-
-					assert(that.data.size() <= this->data.size());
-
-					iterator top = this->data.end()-1;
-					const_iterator bottom = that.data.end()-1;
-					value_type carry = 0;
-
-					//handle both cases separately for speed
-					//+top +bottom or -top -bottom
+					changed();
+					//+top -bottom or -top +bottom
 					if(this->sign != that.sign){
-						while(bottom >= that.data.begin()){
-							value_type sum = (*top+*bottom)+carry;
-							carry = sum / 10;
-							sum %= 10;
-							*top = sum;
-							--top;
-							--bottom;
-						}
-						while(top >= this->data.begin()){
-							value_type sum = *top+carry;
-							carry = sum / 10;
-							sum %= 10;
-							*top = sum;
-							--top;
-						}
-						if(carry) this->data.insert(this->data.begin(), carry);
-					} else { //-top +bottom or +top -bottom
-						//compute top - bottom in base 10
-						carry = 1;
-						while(bottom >= that.data.begin()){
-							//1. Add top to the 10's complement of bottom.
-							value_type sum = (*top+(9-*bottom))+carry;
-							carry = sum / 10;
-							sum %= 10;
-							*top = sum;
-							--top;
-							--bottom;
-						}
-						while(top >= this->data.begin()){
-							value_type sum = *top+9+carry;
-							carry = sum / 10;
-							sum %= 10;
-							*top = sum;
-							--top;
-						}
-						//2. If there is a carry, discard it. What is left is the result top - bottom.
-						//3. If there is no carry, take the 10's complement of the sum
-						if(!carry) {
-							carry = 1;
-							top = this->data.end()-1;
-							while(top >= this->data.begin()){
-								value_type sum = 9-*top+carry;
-								carry = sum / 10;
-								sum %= 10;
-								*top = sum;
-								--top;
-							}
-						}
-
-						if(bottomIsBigger) this->sign = !this->sign;
-
-						//get rid of leading zeros
-						top = this->data.begin();
-						if(0==*top){
-							while(*top==0 && top < this->data.end()-1){
-								++top;
-							}
-							this->data.erase(this->data.begin(), top);
-
-							//turn -0 into 0 if necessary
-							if(this->data.size()==1 && this->data[0]==0)
-								this->sign = false;
-						}
+						addMagnitude(this->data, that.data);
+					} else if(compareMagnitude(this->data, that.data) >= 0){ //+top +bottom or -top -bottom
+						subtractMagnitude(this->data, that.data);
+					} else { //the bottom is bigger, so it flips the sign
+						subtractFromMagnitude(this->data, that.data);
+						this->sign = !this->sign;
 					}
 
+					//turn -0 into 0 if necessary
+					if(isZero()) this->sign = false;
+
 					assert(valid());
 					return *this;}
 
@@ -610,34 +1275,52 @@ namespace alg   {
 				// -----------
 
 				/**
-				* O(n*m) but significantly less if rhs contains many zeros
+				* O(n*m) but significantly less if rhs contains many zeros,
+				* or O(n*m^0.585) once both operands reach KARATSUBA_THRESHOLD digits
 				* M(n + m) where n is the length of lhs and m is the length of rhs
 				* @param that the rhs multiplicand
 				* @return lhs as the product of lhs and rhs
 				*/
 				Integer& operator *= (const Integer& that) {
+					changed();
+					//the sign of the product is the xor of the signs of multiplicands
+					this->sign ^= that.sign;
+
+					//both multiplicands are read through const references, as a non-const call on this->data
+					//may give this, and so that when x *= x, a private copy of shared digits part way through
+					const container_type& lhs = this->data;
+					const container_type& rhs = that.data;
+
+					if(this->size() >= KARATSUBA_THRESHOLD && that.size() >= KARATSUBA_THRESHOLD){
+						//the digit kernels want contiguous unsigned digits
+						std::vector<unsigned> x(lhs.begin(), lhs.end());
+						std::vector<unsigned> y(rhs.begin(), rhs.end());
+						std::vector<unsigned> z(x.size() + y.size());
+						mulDigits(&x[0], x.size(), &y[0], y.size(), &z[0]);
+
+						//neither multiplicand is zero, so the product has no more than one leading zero
+						if(0==z.back()) z.pop_back();
+						this->data.assign(z.begin(), z.end());
+
+						assert(valid());
+						return *this;
+					}
+
 					Integer rval(0); //will hold the result
 
 					//the most digits a product could have is the sum of
 					//the numbers of digits of both multiplicands combined
 					rval.data.resize(this->size() + that.size(), 0);
 
-					//the sign of the product is the xor of the signs of multiplicands
-					this->sign ^= that.sign;
-
-					const_iterator thatBegin = that.data.begin();
-					const_iterator thatEnd = that.data.end()-1;
-					iterator rvalEnd = rval.data.end()-1;
-					for(const_iterator y=that.data.end()-1; y>=thatBegin; --y){
+					typename container_type::iterator shifted = rval.data.begin();
+					for(typename container_type::const_iterator y=rhs.begin(); y!=rhs.end(); ++y, ++shifted){
 						if(*y){
-							const difference_type shift = thatEnd - y;
 							//unsigned was experimentally found to be much faster than value_type
 							unsigned carry = 0;
-							iterator z = rvalEnd-shift;
-							const_iterator thisBegin = this->data.begin();
-							for(const_iterator x=this->data.end()-1;x>=thisBegin; --x){
+							typename container_type::iterator z = shifted;
+							for(typename container_type::const_iterator x=lhs.begin(); x!=lhs.end(); ++x){
 								unsigned prod = (*x) * (*y) + (*z) + carry;
-								*z-- = (prod%10);
+								*z++ = (prod%10);
 								carry = prod / 10;
 							}
 							*z = carry;
@@ -646,21 +1329,11 @@ namespace alg   {
 
 					this->data.swap(rval.data);
 
-					iterator top = this->data.begin();
-					//if there are no leading zeros, return
-					if(*top){
-						assert(valid());
-						return *this;
-					}
-
-					//otherwise get rid of leading zeros
-					while(*top==0 && top < this->data.end()-1){
-						++top;
-					}
-					this->data.erase(this->data.begin(), top);
+					//get rid of leading zeros
+					trim(this->data);
 
 					//turn -0 into 0 if necessary
-					if(this->data.size()==1 && this->data[0]==0)
+					if(isZero())
 						this->sign = false;
 
 					assert(valid());
@@ -673,86 +1346,24 @@ namespace alg   {
 				/**
 				* O(1) or O(n*m) depending if |rhs| > |lhs| or |rhs| < |lhs| respectively
 				* M(1) or M(n) depending if |rhs| > |lhs| or |rhs| < |lhs| respectively
+				* that is only read, so one divisor may be shared by any number of threads
 				* @param that the denominator
 				* @return lhs as the quotient of lhs divided by rhs
 				* @throws std::invalid_argument
 				*/
 				Integer& operator /= (const Integer& that) throw (std::invalid_argument) {
 					// precondition: that != 0
-					if(that == ZERO)
+					if(that.isZero())
 						throw std::invalid_argument("Integer::operator/=()");
+					changed();
 
-					bool thatOldSign = that.sign;
-					bool thisOldSign = this->sign;
-
-					((Integer &)that).sign = false;  //we promise we'll set it back :-)
-					this->sign = false;
-
-					if(that > *this) {
-						this->sign = false;
-						this->data.clear();
-						this->data.push_back(0);
-						((Integer &)that).sign = thatOldSign;
-						return *this;  //in int division, xxx/yyyy == 0
-					}
-
-					Integer rval(0); //will hold the result
-					rval.data.resize(this->size(), 0);
-
-					//      zz
-					//   -----
-					//yyy|xxxx
-
-					Integer s(0);
-					s.data.clear();
-
-					const_iterator x = this->data.begin();
-					const_iterator y = that.data.begin();
-					iterator z = rval.data.begin();
-
-					do{
-						while(s < that && x < this->data.end()){
-							s.data.push_back(*x);
-							++x;
-							++z;
-						}
-						--z;
-
-						//get rid of leading zeros on s if there are any
-						{ iterator sprefix = s.data.begin();
-						if(0==*sprefix){
-							while(0==*sprefix && sprefix < s.data.end()-1){
-								++sprefix;
-							}
-							s.data.erase(s.data.begin(), sprefix);
-						}
-						}
-
-						unsigned t = 0;
-						while(that*Integer(t+1) <= s){
-							++t;
-						}
-
-						*z++ = t;
-						s -= that*t;
-					} while(z < rval.data.end());
-
-					this->data.swap(rval.data);
-					this->sign = thisOldSign ^ thatOldSign;
-					((Integer &)that).sign = thatOldSign;  //see we changed it back.  :-)
-
-					iterator top = this->data.begin();
-					//if there are no leading zeros, return
-					if(*top){
-						assert(valid());
-						return *this;
-					}
+					container_type quotient;
+					container_type remainder;
+					divide(this->data, that.data, quotient, remainder);
+					this->data.swap(quotient);
 
-					//otherwise get rid of leading zeros
-					while(*top==0 && top < this->data.end()-1){
-						++top;
-					}
-					this->data.erase(this->data.begin(), top);
+					//turn -0 into 0 if necessary
+					this->sign = (this->sign != that.sign) && !isZero();
 
 					assert(valid());
 					return *this;}
@@ -763,7 +1374,7 @@ namespace alg   {
 				// -----------
 
 				/**
-				* O(1) or O((n+1)*m) depending if |rhs| > |lhs| or |rhs| <= |lhs| respectively
+				* O(1) or O(n*m) depending if |rhs| > |lhs| or |rhs| <= |lhs| respectively
 				* M(1) or M(n) depending if |rhs| > |lhs| or |rhs| <= |lhs| respectively
 				* @param that the modulus
 				* @return lhs as lhs mod rhs
@@ -772,8 +1383,13 @@ namespace alg   {
 				Integer& operator %= (const Integer& that) throw (std::invalid_argument) {
 					if(that <= ZERO) throw std::invalid_argument("Integer::operator%=()");
 					if(*this < ZERO) throw std::invalid_argument("Integer::operator%=()");
-					//for complexity, this converges to *this -= *this * that
-					*this -= (*this / that) * that;
+					changed();
+
+					container_type quotient;
+					container_type remainder;
+					divide(this->data, that.data, quotient, remainder);
+					this->data.swap(remainder);
+
 					assert(valid());
 					return *this;}
 
@@ -790,8 +1406,9 @@ namespace alg   {
 				* @throws std::out_of_range
 				*/
 				reference at (size_type index) throw (std::out_of_range) {
+					exposed();
 					try{
-						return data.at(data.size()-index-1);
+						return data.at(index);
 					}
 					catch(std::out_of_range &e){
 						throw std::out_of_range("Integer::at()");
@@ -806,7 +1423,13 @@ namespace alg   {
 				* @throws std::out_of_range
 				*/
 				const_reference at (size_type index) const throw (std::out_of_range) {
-					return const_cast<Integer*>(this)->at(index);}
+					try{
+						return data.at(index);
+					}
+					catch(std::out_of_range &e){
+						throw std::out_of_range("Integer::at()");
+					}
+				}
 
 				// -----
 				// begin
@@ -818,7 +1441,8 @@ namespace alg   {
 				* returns iterator that points to most significant digit (does not point at sign)
 				*/
 				iterator begin () {
-					return this->data.begin();}
+					exposed();
+					return iterator(this->data.end());}
 
 				/**
 				* O(1)
@@ -826,7 +1450,7 @@ namespace alg   {
 				* returns iterator that points to most significant digit (does not point at sign)
 				*/
 				const_iterator begin () const {
-					return this->data.begin();}
+					return const_iterator(this->data.end());}
 
 				// ---
 				// end
@@ -838,7 +1462,8 @@ namespace alg   {
 				* returns iterator that points one past the least significant digit
 				*/
 				iterator end () {
-					return this->data.end();}
+					exposed();
+					return iterator(this->data.begin());}
 
 				/**
 				* O(1)
@@ -846,7 +1471,7 @@ namespace alg   {
 				* returns iterator that points one past the least significant digit
 				*/
 				const_iterator end () const {
-					return this->data.end();}
+					return const_iterator(this->data.begin());}
 
 				// ----
 				// size
@@ -860,6 +1485,135 @@ namespace alg   {
 				size_type size () const {
 					return data.size();}
 
+				// ---------
+				// to_string
+				// ---------
+
+				/**
+				* O(n) in base 10, O(n^2) word operations to reach binary otherwise, after which power of two
+				* bases are read off the bits in O(n) and the rest take one word division per group of digits
+				* M(n)
+				* @param base the radix, from 2 to 36
+				* @return *this in the given base, with digits past 9 as lower case letters
+				* @throws std::invalid_argument
+				*/
+				std::string to_string (int base = 10) const throw (std::invalid_argument) {
+					if(base < 2 || base > 36) throw std::invalid_argument("Integer::to_string()");
+					static const char symbols[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+
+					std::string r;
+					if(base == 10){
+						r.reserve(data.size() + 1);
+						if(sign) r += '-';
+						for(typename container_type::const_reverse_iterator i = data.rbegin(); i != data.rend(); ++i)
+							r += symbols[*i];
+						return r;
+					}
+
+					std::vector<std::uint32_t> limbs = to_limbs();
+					int bits = 0;
+					while((1 << bits) < base) ++bits;
+					if(1 << bits == base){
+						//every digit is the next few bits up
+						const std::size_t total = 32*limbs.size();
+						for(std::size_t at = 0; at < total; at += bits){
+							std::uint64_t w = limbs[at/32] >> (at%32);
+							if(at%32 + bits > 32 && at/32 + 1 < limbs.size())
+								w |= std::uint64_t(limbs[at/32 + 1]) << (32 - at%32);
+							r += symbols[w & (base - 1)];
+						}
+					} else {
+						//divide by the largest power of base that fits in a limb, for that many digits at a time
+						std::uint64_t chunk = base;
+						std::size_t k = 1;
+						for(; chunk*base <= 0xFFFFFFFFull; ++k) chunk *= base;
+						while(limbs.size() > 1 || limbs[0]){
+							std::uint32_t rem = divideLimbs(limbs, std::uint32_t(chunk));
+							for(std::size_t j = 0; j < k; ++j, rem /= base)
+								r += symbols[rem % base];
+						}
+					}
+
+					//the digits came least significant first, with zeros up to a whole group
+					while(r.size() > 1 && '0' == r[r.size() - 1]) r.erase(r.size() - 1);
+					if(r.empty()) r = "0";
+					if(sign) r += '-';
+					std::reverse(r.begin(), r.end());
+					return r;}
+
+				// --------
+				// to_limbs
+				// --------
+
+				/**
+				* O(n^2) word operations, a ninth of them per digit as nine digits are taken at a time
+				* M(n)
+				* @return the magnitude of *this in 32 bit limbs, least significant first, without leading zero limbs
+				*/
+				std::vector<std::uint32_t> to_limbs () const {
+					std::vector<std::uint32_t> r(1, 0);
+					typename container_type::const_reverse_iterator i = data.rbegin();
+					//take nine digits at a time, starting with whatever is left over at the top
+					for(size_type left = data.size(); left; ){
+						std::uint64_t chunk = 0;
+						std::uint64_t scale = 1;
+						for(size_type k = left % 9 ? left % 9 : 9; k; --k, --left, ++i){
+							chunk = chunk*10 + *i;
+							scale *= 10;
+						}
+						std::uint64_t carry = chunk;
+						for(std::size_t j=0; j<r.size(); ++j){
+							const std::uint64_t s = std::uint64_t(r[j])*scale + carry;
+							r[j] = std::uint32_t(s);
+							carry = s >> 32;
+						}
+						if(carry) r.push_back(std::uint32_t(carry));
+					}
+					return r;}
+
+				// ----
+				// hash
+				// ----
+
+				/**
+				* O(n) to pack sixteen digits into each word that is mixed, or O(1) once
+				* cached when compiled with INTEGER_CACHE_HASH; an Integer that has handed out a writable
+				* reference or iterator through a non-const operator [], at, begin or end is never cached
+				* M(1)
+				* @return a hash of the value of *this, never 0, equal for equal Integers whatever their container
+				*/
+				std::size_t hash () const {
+#ifdef INTEGER_CACHE_HASH
+					const std::size_t cached = hashed.value.load(std::memory_order_relaxed);
+					if(cached) return cached;
+#endif
+					const std::uint64_t k = 0x9E3779B97F4A7C15ull;
+					std::uint64_t h = data.size() ^ (sign ? k : 0);
+					typename container_type::const_iterator i = data.begin();
+					for(size_type left = data.size(); left; ){
+						//a digit fits in a nibble
+						std::uint64_t w = 0;
+						const size_type n = left < 16 ? left : 16;
+						for(size_type j=0; j<n; ++j, ++i)
+							w |= std::uint64_t(*i) << (4*j);
+						left -= n;
+						h = (h ^ w) * k;
+						h ^= h >> 29;
+					}
+					//murmur3's finaliser, so that every bit of h depends on every digit
+					h ^= h >> 33;
+					h *= 0xFF51AFD7ED558CCDull;
+					h ^= h >> 33;
+					h *= 0xC4CEB9FE1A85EC53ull;
+					h ^= h >> 33;
+					std::size_t r = static_cast<std::size_t>(h);
+					if(!r) r = 1;
+#ifdef INTEGER_CACHE_HASH
+					if(!hashed.writable)
+						hashed.value.store(r, std::memory_order_relaxed);
+#endif
+					return r;}
+
 				// ----
 				// swap
 				// ----
@@ -874,6 +1628,9 @@ namespace alg   {
 					this->sign ^= that.sign;
 					that.sign ^= this->sign;
 					this->sign ^= that.sign;
+#ifdef INTEGER_CACHE_HASH
+					this->hashed.swap(that.hashed);
+#endif
 				}
 
 			};
@@ -905,6 +1662,114 @@ namespace alg   {
 					return x;
 				}
 
+			// -----------
+			// tree_reduce
+			// -----------
+
+			/**
+			* ranges this short are folded left to right rather than split further
+			*/
+			const std::ptrdiff_t TREE_REDUCE_LEAF = 16;
+
+			/**
+			* O(n) applications of op, balanced so that both operands of each application are of similar size
+			* M(log n) partial results are live at any time on each thread
+			* @param first an iterator to the first Integer of the range
+			* @param n the length of the range, must be positive
+			* @param op the compound assignment operator to reduce by
+			* @param depth the number of levels that may still split off a thread for their left half
+			* @param step if not null, called with the combined size of the operands before each application
+			* of op, possibly from several threads at once, and may throw to abandon the reduction
+			* @return first[0] op first[1] op ... op first[n-1]
+			*/
+			template <typename FI, typename T, typename C>
+				Integer<T, C> tree_reduce (FI first, typename std::iterator_traits<FI>::difference_type n,
+				                           Integer<T, C>& (Integer<T, C>::*op)(const Integer<T, C>&), unsigned depth,
+				                           const std::function<void (std::size_t)>* step = 0) {
+					assert(n > 0);
+					if(n <= TREE_REDUCE_LEAF){
+						Integer<T, C> r = *first;
+						while(--n){
+							++first;
+							if(step) (*step)(r.size() + (*first).size());
+							(r.*op)(*first);
+						}
+						return r;
+					}
+
+					const typename std::iterator_traits<FI>::difference_type half = n/2;
+					FI middle = first;
+					std::advance(middle, half);
+
+					Integer<T, C> r(0);
+					Integer<T, C> right(0);
+					if(depth){
+						std::future< Integer<T, C> > left = std::async(std::launch::async, &tree_reduce<FI, T, C>, first, half, op, depth-1, step);
+						right = tree_reduce(middle, n-half, op, depth-1, step);
+						r = left.get();
+					} else {
+						r = tree_reduce(first, half, op, 0, step);
+						right = tree_reduce(middle, n-half, op, 0, step);
+					}
+					if(step) (*step)(r.size() + right.size());
+					(r.*op)(right);
+					return r;}
+
+			/**
+			* O(1)
+			* M(1)
+			* @return how many levels of a reduction tree should fork a thread to keep every core busy
+			*/
+			inline unsigned tree_reduce_depth () {
+				unsigned depth = 0;
+				for(unsigned cores = std::thread::hardware_concurrency(); cores > 1; cores = (cores+1)/2)
+					++depth;
+				return depth;}
+
+			// -------
+			// product
+			// -------
+
+			/**
+			* product of a sequence
+			*/
+
+			/**
+			* O(M(N) log n) where N is the size of the product and M the cost of multiplying two N/2 digit halves
+			* M(N log n) across the partial products alive on all threads
+			* @param first an iterator to the first Integer to multiply
+			* @param last an iterator one past the last Integer to multiply
+			* @return the product of [first, last), or ONE if the range is empty
+			*/
+			template <typename FI>
+				typename std::iterator_traits<FI>::value_type product (FI first, FI last) {
+					typedef typename std::iterator_traits<FI>::value_type integer_type;
+					const typename std::iterator_traits<FI>::difference_type n = std::distance(first, last);
+					if(!n) return integer_type::ONE;
+					return tree_reduce(first, n, &integer_type::operator*=, tree_reduce_depth());}
+
+			// ---
+			// sum
+			// ---
+
+			/**
+			* sum of a sequence
+			*/
+
+			/**
+			* O(N) where N is the total number of digits in the range
+			* M(log n) partial sums are live at any time on each thread
+			* @param first an iterator to the first Integer to add
+			* @param last an iterator one past the last Integer to add
+			* @return the sum of [first, last), or ZERO if the range is empty
+			*/
+			template <typename FI>
+				typename std::iterator_traits<FI>::value_type sum (FI first, FI last) {
+					typedef typename std::iterator_traits<FI>::value_type integer_type;
+					const typename std::iterator_traits<FI>::difference_type n = std::distance(first, last);
+					if(!n) return integer_type::ZERO;
+					return tree_reduce(first, n, &integer_type::operator+=, tree_reduce_depth());}
+
 				// ----
 				// fact
 				// ----
@@ -914,8 +1779,8 @@ namespace alg   {
 				*/
 
 				/**
-				* O((n^2)!)
-				* M(n-log (n^2)!)
+				* O(M(log x!) log x) where M is the cost of multiplying the two halves of the product tree
+				* M(x) for the factors plus M(log x!) for the product
 				* @param x an Integer
 				* @return the factorial of x
 				* @throws std::invalid_argument
@@ -923,12 +1788,11 @@ namespace alg   {
 				template <typename T, typename C>
 					Integer<T, C> fact (const Integer<T, C>& x) throw (std::invalid_argument) {
 						if(x < Integer<T,C>::ZERO) throw std::invalid_argument("fact()");
-						if(x == Integer<T,C>::ZERO) return Integer<T,C>::ONE;  //0! == 1
-						Integer<T, C> r = Integer<T,C>::ONE;
-						for(Integer<T, C> i = x;i > Integer<T,C>::ONE; --i){
-							r *= i;
+						std::vector< Integer<T, C> > factors;
+						for(Integer<T, C> i = 2; i <= x; ++i){
+							factors.push_back(i);
 						}
-						return r;}
+						return product(factors.begin(), factors.end());}  //0! == 1! == 1, the empty product
 
 					// ---
 					// gcd
@@ -992,9 +1856,257 @@ namespace alg   {
 								return e*e;
 							}
 
+			// -----
+			// iroot
+			// -----
+
+			/**
+			* integer k-th root
+			*/
+
+			/**
+			* O(log w) multiplications of words
+			* M(1)
+			* @param w a word
+			* @param k the root, at least 2
+			* @return the largest r such that r^k <= w
+			*/
+			inline unsigned long long iroot (unsigned long long w, int k) {
+				//is r^k <= w, computed without overflowing
+				struct fits {
+					static bool test (unsigned long long r, int k, unsigned long long w) {
+						unsigned long long p = 1;
+						for(int i=0; i<k; ++i){
+							if(r && p > w / r) return false;
+							p *= r;
+						}
+						return p <= w;}
+				};
+				unsigned long long r = static_cast<unsigned long long>(std::pow(static_cast<double>(w), 1.0/k));
+				while(r && !fits::test(r, k, w)) --r;
+				while(fits::test(r+1, k, w)) ++r;
+				return r;}
+
+			/**
+			* O(M(n) log k) per Newton step, and as the precision doubles each level of the
+			* recursion only a couple of steps are taken at full precision
+			* M(n)
+			* @param x an Integer
+			* @param k the root, which must be positive, and odd if x is negative
+			* @return the k-th root of x, truncated toward zero
+			* @throws std::invalid_argument
+			*/
+			template <typename T, typename C>
+				Integer<T, C> iroot (const Integer<T, C>& x, int k) throw (std::invalid_argument) {
+					if(k < 1) throw std::invalid_argument("iroot()");
+					if(x < Integer<T, C>::ZERO){
+						if(!(k & 1)) throw std::invalid_argument("iroot()");
+						return -iroot(-x, k);
+					}
+					if(k == 1) return x;
+					if(x.size() <= 19) return Integer<T, C>::fromWide(iroot(x.toWide(), k));
+
+					if(x.size() <= 15*static_cast<typename Integer<T, C>::size_type>(k)){
+						//the root has no more than 15 digits, few enough for a floating point estimate
+						//from the leading digits of x to be off by only a unit or two
+						double lead = 0;
+						typename Integer<T, C>::size_type n = 0;
+						for(typename Integer<T, C>::const_iterator i = x.begin(); n < 17; ++i, ++n)
+							lead = lead*10 + *i;
+						const double digits = std::log10(lead) + static_cast<double>(x.size() - n);
+						Integer<T, C> r = Integer<T, C>::fromWide(static_cast<unsigned long long>(std::pow(10.0, digits/k)));
+						while(pow(r, k) > x) --r;
+						for(Integer<T, C> next = r+Integer<T, C>::ONE; pow(next, k) <= x; ++next) ++r;
+						return r;
+					}
+
+					//the root has about x.size()/k digits; find the top half of them from the top
+					//k*j digits of x, which gives an estimate that is never too small and is correct
+					//to about j digits, then let Newton double that
+					const typename Integer<T, C>::size_type j = (x.size()/k + 1)/2;
+					Integer<T, C> top = x;
+					top.shiftRight(j*k);
+					Integer<T, C> r = iroot(top, k);
+					++r;
+					r.shiftLeft(j);
+
+					//r' = ((k-1)*r + x/r^(k-1)) / k decreases until it reaches the root
+					for(;;){
+						Integer<T, C> next = r * Integer<T, C>(k-1) + x / pow(r, k-1);
+						next.divideSmall(k);
+						if(!(next < r)) return r;
+						r.swap(next);
+					}
+				}
+
+			// -----
+			// isqrt
+			// -----
+
+			/**
+			* integer square root
+			*/
+
+			/**
+			* O(M(n)) with the Newton iteration of iroot
+			* M(n)
+			* @param x a non-negative Integer
+			* @return the largest r such that r*r <= x
+			* @throws std::invalid_argument
+			*/
+			template <typename T, typename C>
+				Integer<T, C> isqrt (const Integer<T, C>& x) throw (std::invalid_argument) {
+					if(x < Integer<T, C>::ZERO) throw std::invalid_argument("isqrt()");
+					return iroot(x, 2);}
+
+			// ---------
+			// is_square
+			// ---------
+
+			/**
+			* perfect square test
+			*/
+
+			/**
+			* O(n) for the residue filter, which lets through about 1 in 170 non-squares,
+			* then O(M(n)) for isqrt
+			* M(n)
+			* @param x an Integer
+			* @return true if x is the square of an Integer
+			*/
+			template <typename T, typename C>
+				bool is_square (const Integer<T, C>& x) {
+					if(x < Integer<T, C>::ZERO) return false;
+
+					//reduce once by 64*63*65*11 and look the residue up modulo each factor
+					static const unsigned moduli[] = {64, 63, 65, 11};
+					const unsigned long long r = x.moduloSmall(64ull*63*65*11);
+					for(std::size_t i=0; i<sizeof moduli / sizeof *moduli; ++i){
+						const unsigned m = moduli[i];
+						bool residue = false;
+						for(unsigned y=0; y<m && !residue; ++y)
+							residue = (y*y) % m == r % m;
+						if(!residue) return false;
+					}
+
+					const Integer<T, C> s = isqrt(x);
+					return s*s == x;}
+
+			// ----------------
+			// is_perfect_power
+			// ----------------
+
+			/**
+			* perfect power test
+			*/
+
+			/**
+			* O(n) passes to strip the primes below 1000, then at most one root for each prime
+			* exponent e up to log_1000 |x| that divides the multiplicity of every stripped prime
+			* M(n)
+			* @param x an Integer
+			* @return true if x == y^e for some Integer y and some e >= 2
+			*/
+			template <typename T, typename C>
+				bool is_perfect_power (const Integer<T, C>& x) {
+					typedef typename Integer<T, C>::size_type size_type;
+					Integer<T, C> a = abs(x);
+					if(a <= Integer<T, C>::ONE) return true;  //0 == 0^2, 1 == 1^2, -1 == (-1)^3
+					const bool negative = x < Integer<T, C>::ZERO;
+
+					//x can only be an e-th power if e divides the multiplicity of every prime in it.
+					//Test a batch of small primes against one residue, dividing out those that divide.
+					unsigned long long g = 0;
+					for(unsigned long long q=2; q<1000; ){
+						unsigned long long batch[16];
+						std::size_t n = 0;
+						unsigned long long product = 1;
+						for(; q<1000 && n<16 && product < 100000000000000ull; ++q){
+							bool prime = true;
+							for(unsigned long long d=2; d*d<=q && prime; ++d)
+								prime = q % d != 0;
+							if(prime){
+								batch[n++] = q;
+								product *= q;
+							}
+						}
+						const unsigned long long r = a.moduloSmall(product);
+						for(std::size_t i=0; i<n; ++i){
+							if(r % batch[i]) continue;
+							unsigned long long v = 0;
+							do{
+								a.divideSmall(batch[i]);
+								++v;
+							} while(!a.moduloSmall(batch[i]));
+							while(v){ //g = gcd(g, v)
+								const unsigned long long t = g % v;
+								g = v;
+								v = t;
+							}
+							if(g == 1) return false;
+						}
+					}
+
+					if(a == Integer<T, C>::ONE){
+						//every prime was small; negative numbers need an odd exponent
+						while(negative && !(g & 1)) g >>= 1;
+						return g > 1;
+					}
+
+					//what is left has no prime below 1000, so its e-th root is at least 1000
+					const unsigned long long p1 = 2147483647ull;
+					const unsigned long long p2 = 2147483629ull;
+					const unsigned long long a1 = a.moduloSmall(p1);
+					const unsigned long long a2 = a.moduloSmall(p2);
+					const size_type bound = a.size()/3 + 1;
+					for(size_type e = negative ? 3 : 2; e<=bound; ++e){
+						bool prime = true;
+						for(size_type d=2; d*d<=e && prime; ++d)
+							prime = e % d != 0;
+						if(!prime || (g && g % e)) continue;
+
+						if(e == 2){
+							if(is_square(a)) return true;
+							continue;
+						}
+
+						//compare the residues of r^e before paying for the power itself
+						const Integer<T, C> r = iroot(a, static_cast<int>(e));
+						unsigned long long b1 = r.moduloSmall(p1), r1 = 1;
+						unsigned long long b2 = r.moduloSmall(p2), r2 = 1;
+						for(size_type k=e; k; k>>=1){
+							if(k & 1){
+								r1 = r1*b1 % p1;
+								r2 = r2*b2 % p2;
+							}
+							b1 = b1*b1 % p1;
+							b2 = b2*b2 % p2;
+						}
+						if(r1 == a1 && r2 == a2 && pow(r, static_cast<int>(e)) == a) return true;
+					}
+					return false;}
+
 		} // integer
 	} // prog
 } // alg
 
+// ----
+// hash
+// ----
+
+namespace std {
+	/**
+	* lets Integers key unordered containers
+	*/
+	template <typename T, typename C>
+	struct hash< alg::prog::integer::Integer<T, C> > {
+		typedef alg::prog::integer::Integer<T, C> argument_type;
+		typedef std::size_t                       result_type;
+
+		result_type operator () (const argument_type& x) const {
+			return x.hash();}
+	};
+} // std
+
 #endif // Integer_h
 
@@ -0,0 +1,470 @@
+// -----------------------
+// integer/IntegerAsync.h
+// Tj Wrenn
+// -----------------------
+
+#ifndef IntegerAsync_h
+#define IntegerAsync_h
+
+// --------
+// includes
+// --------
+
+#include <atomic>     // atomic
+#include <chrono>     // seconds
+#include <cmath>      // log10, pow
+#include <cstddef>    // size_t
+#include <exception>  // current_exception
+#include <functional> // function
+#include <future>     // async, future, future_status, promise
+#include <memory>     // make_shared, shared_ptr
+#include <mutex>      // lock_guard, mutex
+#include <stdexcept>  // invalid_argument, runtime_error
+#include <thread>     // thread
+#include <utility>    // move
+#include <vector>     // vector
+
+#include "Integer.h"
+
+// ----------
+// namespaces
+// ----------
+
+namespace alg   {
+	namespace prog    {
+		namespace integer {
+
+			// ---------
+			// Cancelled
+			// ---------
+
+			/**
+			* thrown out of an asynchronous computation, and so out of its future's get(), once its token is cancelled
+			*/
+			class Cancelled : public std::runtime_error {
+				public:
+					Cancelled () : std::runtime_error("Cancelled") {}
+			};
+
+			// -----------------
+			// CancellationToken
+			// -----------------
+
+			/**
+			* a flag shared by all of its copies, so that one copy can be handed to a computation and another
+			* kept to cancel it.  The computation checks the flag between steps and throws Cancelled once it is set.
+			*/
+			class CancellationToken {
+				private:
+					std::shared_ptr< std::atomic<bool> > flag;
+
+				public:
+					CancellationToken () : flag(std::make_shared< std::atomic<bool> >(false)) {}
+
+					/**
+					* O(1)
+					* M(1)
+					* asks every computation holding a copy of this token to stop at its next step
+					*/
+					void cancel () {
+						flag->store(true);}
+
+					/**
+					* O(1)
+					* M(1)
+					* @return true once any copy of this token has been cancelled
+					*/
+					bool cancelled () const {
+						return flag->load();}
+			};
+
+			// --------
+			// Executor
+			// --------
+
+			/**
+			* runs the task it is given, now or later and on whatever thread it likes, such as a pool's submit
+			*/
+			typedef std::function<void (std::function<void ()>)> Executor;
+
+			// -------------
+			// JoinedThreads
+			// -------------
+
+			/**
+			* the threads started by joined_thread, each held by the std::future that std::async gave for it
+			*/
+			class JoinedThreads {
+				private:
+					std::mutex                       lock;
+					std::vector< std::future<void> > running;
+
+					JoinedThreads () {}
+
+				public:
+					/**
+					* waits for every task still running.  The instance is made by the first task, after Integer's
+					* ZERO and ONE, and so is destroyed before them, which leaves no task running once they are gone.
+					*/
+					~JoinedThreads () {
+						for(;;){
+							std::vector< std::future<void> > left;
+							{
+								std::lock_guard<std::mutex> guard(lock);
+								left.swap(running);
+							}
+							if(left.empty()) return;
+							for(std::size_t i=0; i<left.size(); ++i)
+								left[i].wait();
+						}}
+
+					/**
+					* @return the one instance, made on the first call
+					*/
+					static JoinedThreads& instance () {
+						static JoinedThreads threads;
+						return threads;}
+
+					/**
+					* O(t) for the t tasks still held
+					* M(t)
+					* @param task run on a thread of its own
+					*/
+					void start (std::function<void ()> task) {
+						std::lock_guard<std::mutex> guard(lock);
+						//let go of the tasks that have finished, which joins their threads
+						std::size_t kept = 0;
+						for(std::size_t i=0; i<running.size(); ++i){
+							if(running[i].wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+								running[kept++] = std::move(running[i]);
+						}
+						running.resize(kept);
+						running.push_back(std::async(std::launch::async, task));}
+			};
+
+			/**
+			* the default Executor, which gives every task a thread of its own and joins each one, at the
+			* latest when the program exits, so that exit waits for any task that was neither finished nor cancelled
+			*/
+			inline void joined_thread (std::function<void ()> task) {
+				JoinedThreads::instance().start(task);}
+
+			/**
+			* an Executor to opt into, which gives every task a thread of its own and detaches it.  A task
+			* still running when main returns may then use Integer's ZERO and ONE after they are destroyed,
+			* so every such task must be finished or cancelled, and its future waited on, before then.
+			*/
+			inline void detached_thread (std::function<void ()> task) {
+				std::thread(task).detach();}
+
+			// ------------
+			// AsyncOptions
+			// ------------
+
+			/**
+			* where an asynchronous computation runs, how it is cancelled, and who hears of its progress
+			*/
+			struct AsyncOptions {
+				Executor                     executor;  //runs the computation
+				CancellationToken            token;     //checked between the steps of the computation
+				std::function<void (double)> progress;  //if set, called with the fraction done so far, possibly from several threads at once
+
+				AsyncOptions () : executor(joined_thread) {}
+			};
+
+			/**
+			* dividends with fewer digits than this are divided on the calling thread by divide_async
+			*/
+			const std::size_t ASYNC_DIVIDE_THRESHOLD = 2000;
+
+			// ----------
+			// Checkpoint
+			// ----------
+
+			/**
+			* counts the work of one computation against an estimate of its total, forwarding the fraction done
+			* to the progress callback and throwing Cancelled once the token is cancelled
+			*/
+			class Checkpoint {
+				private:
+					const AsyncOptions& options;
+					const double total;
+					double done;
+					std::mutex lock;
+
+				public:
+					/**
+					* @param o the options of the computation
+					* @param t an estimate of the total work, in the units later passed to operator ()
+					*/
+					Checkpoint (const AsyncOptions& o, double t) : options(o), total(t), done(0) {}
+
+					/**
+					* O(1)
+					* M(1)
+					* @param work the work about to be done, or just done
+					* @throws Cancelled
+					*/
+					void operator () (double work) {
+						if(options.token.cancelled()) throw Cancelled();
+						if(!options.progress) return;
+						double fraction;
+						{
+							std::lock_guard<std::mutex> guard(lock);
+							done += work;
+							fraction = total > 0 && done < total ? done / total : 1;
+						}
+						options.progress(fraction);}
+
+					/**
+					* O(1)
+					* M(1)
+					* reports the computation as done, whatever the estimate of its total said
+					*/
+					void finish () {
+						if(options.progress) options.progress(1);}
+
+					/**
+					* O(1)
+					* M(1)
+					* @param size the number of digits in the operands of a multiplication
+					* @return an estimate of the multiplication's cost, as Karatsuba grows by size^log2(3)
+					*/
+					static double cost (double size) {
+						return std::pow(size, 1.585);}
+
+					/**
+					* O(n*m)
+					* M(n+m)
+					* @param n the dividend
+					* @param d the divisor, which must not be zero
+					* @param step called with 256 for every 256 digits of n, and may throw to abandon the division
+					* @return n / d truncated toward zero
+					*/
+					template <typename T, typename C>
+						static Integer<T, C> divide (const Integer<T, C>& n, const Integer<T, C>& d,
+						                             const std::function<void (typename Integer<T, C>::size_type)>& step) {
+							assert(!d.isZero());
+							Integer<T, C> q(0);
+							typename Integer<T, C>::container_type r;
+							Integer<T, C>::divide(n.data, d.data, q.data, r, &step);
+							q.sign = (n.sign != d.sign) && !q.isZero();
+							return q;}
+
+					/**
+					* O(n*m)
+					* M(n+m)
+					* @param n the dividend, which must not be negative
+					* @param d the divisor, which must be positive
+					* @param step called with 256 for every 256 digits of n, and may throw to abandon the division
+					* @return n % d
+					*/
+					template <typename T, typename C>
+						static Integer<T, C> remainder (const Integer<T, C>& n, const Integer<T, C>& d,
+						                                const std::function<void (typename Integer<T, C>::size_type)>& step) {
+							assert(!d.isZero());
+							typename Integer<T, C>::container_type q;
+							Integer<T, C> r(0);
+							Integer<T, C>::divide(n.data, d.data, q, r.data, &step);
+							return r;}
+			};
+
+			/**
+			* O(1) on the calling thread
+			* M(1) on the calling thread
+			* @param options whose executor runs f
+			* @param f computes the result, reporting to and checking options along the way
+			* @return the future result of f, or the exception it threw
+			*/
+			template <typename R, typename F>
+				std::future<R> submit (const AsyncOptions& options, F f) {
+					std::shared_ptr< std::promise<R> > p = std::make_shared< std::promise<R> >();
+					std::future<R> r = p->get_future();
+					options.executor([p, f] () {
+						try {
+							p->set_value(f());
+						}
+						catch(...) {
+							p->set_exception(std::current_exception());
+						}
+					});
+					return r;}
+
+			// ---------
+			// pow_async
+			// ---------
+
+			/**
+			* O(log exp) multiplications, any of which may be the last before a cancellation is noticed
+			* M(log (n^exp))
+			* @param x the base
+			* @param exp the exponent
+			* @param options where to run, how to cancel, and who to tell of progress, by multiplication cost
+			* @return the future x^exp, which holds std::invalid_argument if exp is negative, or Cancelled
+			*/
+			template <typename T, typename C>
+				std::future< Integer<T, C> > pow_async (const Integer<T, C>& x, int exp, const AsyncOptions& options = AsyncOptions()) {
+					return submit< Integer<T, C> >(options, [x, exp, options] () -> Integer<T, C> {
+						if(exp < 0) throw std::invalid_argument("pow_async()");
+						if(!exp) return Integer<T, C>::ONE;
+
+						//x^p has about p*log10|x| digits, with log10|x| taken from the leading digits of x
+						int top = 0;
+						while(exp >> (top+1)) ++top;
+						double lead = 0;
+						typename Integer<T, C>::size_type n = 0;
+						for(typename Integer<T, C>::const_iterator i = x.begin(); i != x.end() && n < 17; ++i, ++n)
+							lead = lead*10 + *i;
+						const double digits = lead > 0 ? std::log10(lead) + static_cast<double>(x.size() - n) : 0;
+						double total = 0;
+						for(int b=top-1, p=1; b>=0; --b){
+							total += Checkpoint::cost(2*p*digits);
+							p = 2*p + ((exp >> b) & 1);
+							if((exp >> b) & 1) total += Checkpoint::cost(p*digits);
+						}
+
+						//each squaring costs about three times the one before, so progress is counted
+						//once a multiplication is done rather than before it starts
+						Checkpoint check(options, total);
+						Integer<T, C> r = x;
+						for(int b=top-1; b>=0; --b){
+							check(0);
+							r *= r;
+							check(Checkpoint::cost(static_cast<double>(r.size())));
+							if((exp >> b) & 1){
+								r *= x;
+								check(Checkpoint::cost(static_cast<double>(r.size())));
+							}
+						}
+						check.finish();
+						return r;});}
+
+			// ----------
+			// fact_async
+			// ----------
+
+			/**
+			* O(M(log x!) log x), as fact, with the top levels of the product tree on threads of their own
+			* M(x) for the factors plus M(log x!) for the product
+			* @param x an Integer
+			* @param options where to run, how to cancel, and who to tell of progress, by multiplication cost
+			* @return the future x!, which holds std::invalid_argument if x is negative, or Cancelled
+			*/
+			template <typename T, typename C>
+				std::future< Integer<T, C> > fact_async (const Integer<T, C>& x, const AsyncOptions& options = AsyncOptions()) {
+					return submit< Integer<T, C> >(options, [x, options] () -> Integer<T, C> {
+						if(x < Integer<T, C>::ZERO) throw std::invalid_argument("fact_async()");
+						std::vector< Integer<T, C> > factors;
+						for(Integer<T, C> i = 2; i <= x; ++i){
+							if(options.token.cancelled()) throw Cancelled();
+							factors.push_back(i);
+						}
+						if(factors.empty()) return Integer<T, C>::ONE;
+
+						//walk the shape of the product tree over the sizes of the factors to estimate its cost
+						struct tree {
+							static double cost (const double* size, std::size_t n, double& product) {
+								if(n <= static_cast<std::size_t>(TREE_REDUCE_LEAF)){
+									double c = 0;
+									product = size[0];
+									for(std::size_t i=1; i<n; ++i){
+										c += Checkpoint::cost(product + size[i]);
+										product += size[i];
+									}
+									return c;
+								}
+								double left;
+								double right;
+								const double c = cost(size, n/2, left) + cost(size + n/2, n - n/2, right);
+								product = left + right;
+								return c + Checkpoint::cost(product);}
+						};
+						std::vector<double> sizes(factors.size());
+						for(std::size_t i=0; i<factors.size(); ++i)
+							sizes[i] = static_cast<double>(factors[i].size());
+						double digits;
+						Checkpoint check(options, tree::cost(&sizes[0], sizes.size(), digits));
+
+						const std::function<void (std::size_t)> step = [&check] (std::size_t size) {
+							check(Checkpoint::cost(static_cast<double>(size)));};
+						Integer<T, C> r = tree_reduce(factors.begin(), factors.size(), &Integer<T, C>::operator*=, tree_reduce_depth(), &step);
+						check.finish();
+						return r;});}
+
+			// ---------
+			// gcd_async
+			// ---------
+
+			/**
+			* O(?) as gcd, with progress by the digits the remainders have shed and the token checked every
+			* 256 digits of each division
+			* M(n+m)
+			* @param x an Integer
+			* @param y an Integer
+			* @param options where to run, how to cancel, and who to tell of progress
+			* @return the future gcd of x and y, which holds std::invalid_argument as gcd would, or Cancelled
+			*/
+			template <typename T, typename C>
+				std::future< Integer<T, C> > gcd_async (const Integer<T, C>& x, const Integer<T, C>& y, const AsyncOptions& options = AsyncOptions()) {
+					return submit< Integer<T, C> >(options, [x, y, options] () -> Integer<T, C> {
+						if(x==Integer<T,C>::ZERO && y==Integer<T,C>::ZERO) throw std::invalid_argument("gcd_async()");
+						if(x<Integer<T,C>::ZERO || y<Integer<T,C>::ZERO) throw std::invalid_argument("gcd_async()");
+
+						//make sure that we don't div by zero
+						Integer<T, C> b = (y == Integer<T,C>::ZERO) ? x : y;
+						Integer<T, C> a = (y == Integer<T,C>::ZERO) ? y : x;
+
+						//the token is also checked every 256 digits inside each division, the first of which
+						//can take as long as all the rest when x and y differ greatly in size
+						Checkpoint check(options, static_cast<double>(a.size() + b.size()));
+						const std::function<void (typename Integer<T, C>::size_type)> step = [&check] (typename Integer<T, C>::size_type) {
+							check(0);};
+						while(b!=Integer<T,C>::ZERO){
+							const double before = static_cast<double>(a.size() + b.size());
+							Integer<T,C> t = b;
+							b = Checkpoint::remainder(a, b, step);
+							a.swap(t);
+							check(before - static_cast<double>(a.size() + b.size()));
+						}
+						check.finish();
+						return a;});}
+
+			// ------------
+			// divide_async
+			// ------------
+
+			/**
+			* O(n*m), on the calling thread if x has fewer than ASYNC_DIVIDE_THRESHOLD digits
+			* M(n)
+			* @param x the dividend
+			* @param y the divisor
+			* @param options where to run, how to cancel, and who to tell of progress, by digits of x
+			* @return the future x / y, which holds std::invalid_argument if y is zero, or Cancelled
+			*/
+			template <typename T, typename C>
+				std::future< Integer<T, C> > divide_async (const Integer<T, C>& x, const Integer<T, C>& y, const AsyncOptions& options = AsyncOptions()) {
+					if(x.size() < ASYNC_DIVIDE_THRESHOLD){
+						std::promise< Integer<T, C> > p;
+						try {
+							if(options.token.cancelled()) throw Cancelled();
+							p.set_value(x / y);
+						}
+						catch(...) {
+							p.set_exception(std::current_exception());
+						}
+						return p.get_future();
+					}
+					return submit< Integer<T, C> >(options, [x, y, options] () -> Integer<T, C> {
+						if(y == Integer<T, C>::ZERO) throw std::invalid_argument("divide_async()");
+						Checkpoint check(options, static_cast<double>(x.size()));
+						const std::function<void (typename Integer<T, C>::size_type)> step = [&check] (typename Integer<T, C>::size_type digits) {
+							check(static_cast<double>(digits));};
+						Integer<T, C> q = Checkpoint::divide(x, y, step);
+						check.finish();
+						return q;});}
+
+		} // integer
+	} // prog
+} // alg
+
+#endif // IntegerAsync_h
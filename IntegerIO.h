@@ -0,0 +1,433 @@
+// --------------------
+// integer/IntegerIO.h
+// Tj Wrenn
+// --------------------
+
+#ifndef IntegerIO_h
+#define IntegerIO_h
+
+// --------
+// includes
+// --------
+
+#include <cctype>       // isspace
+#include <cerrno>       // errno, EINTR
+#include <cstring>      // memcmp
+#include <iostream>     // ostream
+#include <string>       // string
+#include <system_error> // system_error, generic_category
+
+#include <fcntl.h>      // open, posix_fallocate
+#include <sys/mman.h>   // madvise, mmap, munmap
+#include <sys/stat.h>   // fstat, S_ISREG
+#include <unistd.h>     // close, read
+
+#include "Integer.h"
+
+// ----------
+// namespaces
+// ----------
+
+namespace alg   {
+	namespace prog    {
+		namespace integer {
+
+			// ----
+			// read
+			// ----
+
+			/**
+			* read an Integer from a file descriptor
+			*/
+
+			/**
+			* O(n)
+			* M(n) the digits are parsed in fixed size chunks straight into x's container,
+			* which is reserved up front when fd refers to a regular file
+			* @param fd a file descriptor holding the number in base 10, optionally surrounded by whitespace
+			* @param x receives the number, and is left unchanged if anything is thrown
+			* @throws std::invalid_argument
+			* @throws std::system_error
+			*/
+			template <typename T, typename C>
+				void read (int fd, Integer<T, C>& x) throw (std::invalid_argument, std::system_error) {
+					struct stat info;
+					if(::fstat(fd, &info) < 0)
+						throw std::system_error(errno, std::generic_category(), "read()");
+
+					typename Integer<T, C>::Parser p(S_ISREG(info.st_mode) ? info.st_size : 0);
+					char chunk[1 << 16];
+					bool leading = true;   //true until the first non-whitespace character
+					bool trailing = false; //true once whitespace has followed the number
+					for(;;){
+						const ssize_t n = ::read(fd, chunk, sizeof chunk);
+						if(n < 0){
+							if(EINTR == errno) continue;
+							throw std::system_error(errno, std::generic_category(), "read()");
+						}
+						if(!n) break;
+
+						const char* first = chunk;
+						const char* last = chunk + n;
+						if(leading){
+							while(first < last && std::isspace(static_cast<unsigned char>(*first))) ++first;
+							if(first == last) continue;
+							leading = false;
+						}
+						const char* end = last;
+						while(end > first && std::isspace(static_cast<unsigned char>(end[-1]))) --end;
+						if(first < end && trailing) //whitespace in the middle of the number
+							throw std::invalid_argument("read()");
+						p.feed(first, end);
+						trailing = trailing || end < last;
+					}
+					Integer<T, C> r = p.finish();
+					x.swap(r);}
+
+			// -----------
+			// MappedFile
+			// -----------
+
+			/**
+			* owns a file descriptor and a mapping of the whole file, releasing both when destroyed
+			*/
+			class MappedFile {
+			public:
+				/**
+				* O(1) the pages are only read in when touched, or O(n) on filesystems that cannot reserve blocks
+				* without writing them
+				* M(1)
+				* @param path the file to map
+				* @param size the size to give the file first, or -1 to map it read only at its current size
+				* @throws std::system_error if the file cannot be opened or mapped, or if there is no room for size bytes
+				*/
+				MappedFile (const std::string& path, off_t size = -1) throw (std::system_error) : fd(-1), first(0), length(0) {
+					const bool writing = size >= 0;
+					fd = ::open(path.c_str(), writing ? O_RDWR | O_CREAT | O_TRUNC : O_RDONLY, 0644);
+					if(fd < 0) fail("MappedFile::MappedFile()");
+
+					struct stat info;
+					if(writing){
+						//reserve every block now, as running out of room while the mapped pages are written
+						//would raise SIGBUS rather than return an error
+						if(size > 0){
+							const int error = ::posix_fallocate(fd, 0, size);
+							if(error){
+								errno = error;
+								fail("MappedFile::MappedFile()");
+							}
+						}
+					} else {
+						if(::fstat(fd, &info) < 0) fail("MappedFile::MappedFile()");
+						size = info.st_size;
+					}
+					length = size;
+
+					//mmap refuses empty mappings, an empty file is left for the caller to reject
+					if(!length) return;
+					void* p = ::mmap(0, length, writing ? PROT_READ | PROT_WRITE : PROT_READ, writing ? MAP_SHARED : MAP_PRIVATE, fd, 0);
+					if(MAP_FAILED == p) fail("MappedFile::MappedFile()");
+					first = static_cast<char*>(p);
+					::madvise(first, length, MADV_SEQUENTIAL);}
+
+				/**
+				* O(1)
+				* M(1)
+				*/
+				~MappedFile () {
+					release();}
+
+				/**
+				* O(1)
+				* M(1)
+				* @return the first byte of the file
+				*/
+				char* begin () const {
+					return first;}
+
+				/**
+				* O(1)
+				* M(1)
+				* @return one past the last byte of the file
+				*/
+				char* end () const {
+					return first + length;}
+
+			private:
+				MappedFile (const MappedFile&);
+				MappedFile& operator = (const MappedFile&);
+
+				int fd;
+				char* first;
+				std::size_t length;
+
+				/**
+				* O(1)
+				* M(1)
+				*/
+				void release () {
+					if(first) ::munmap(first, length);
+					if(fd >= 0) ::close(fd);
+					first = 0;
+					fd = -1;}
+
+				/**
+				* @throws std::system_error
+				*/
+				void fail (const char* where) throw (std::system_error) {
+					const int error = errno;
+					release();
+					throw std::system_error(error, std::generic_category(), where);}
+			};
+
+			// ----
+			// save
+			// ----
+
+			/**
+			* write an Integer to a file through a memory mapping
+			*/
+
+			/**
+			* O(n)
+			* M(1) the digits are written straight into the mapped pages
+			* @param path the file to create or replace, which receives x in base 10 with no trailing newline
+			* @param x an Integer
+			* @throws std::system_error
+			*/
+			template <typename T, typename C>
+				void save (const std::string& path, const Integer<T, C>& x) throw (std::system_error) {
+					const bool negative = x < Integer<T, C>::ZERO;
+					MappedFile file(path, x.size() + negative);
+					char* out = file.begin();
+					if(negative) *out++ = '-';
+					for(typename Integer<T, C>::const_iterator i = x.begin(); i != x.end(); ++i)
+						*out++ = static_cast<char>('0' + *i);
+					assert(out == file.end());}
+
+			// -----
+			// strip
+			// -----
+
+			/**
+			* O(k) in the whitespace removed
+			* M(1)
+			* moves first and last inward past any whitespace at either end of [first, last)
+			*/
+			inline void strip (const char*& first, const char*& last) {
+				while(first < last && std::isspace(static_cast<unsigned char>(*first))) ++first;
+				while(last > first && std::isspace(static_cast<unsigned char>(last[-1]))) --last;}
+
+			// -----------
+			// IntegerView
+			// -----------
+
+			/**
+			* a read only Integer whose digits stay in a memory mapped file, as written by save().
+			* Views compare with each other and with Integers without bringing the digits onto the heap.
+			*/
+			class IntegerView {
+				/**
+				* O(1) or O(n) depending on if the sizes differ or are the same respectively
+				* M(1)
+				* @param lhs an IntegerView
+				* @param rhs an IntegerView
+				* @return negative, zero or positive as lhs is less than, equal to, or greater than rhs
+				*/
+				friend int compare (const IntegerView& lhs, const IntegerView& rhs) {
+					if(lhs.sign != rhs.sign) return lhs.sign ? -1 : 1;
+					int r = (lhs.size() == rhs.size()) ? std::memcmp(lhs.first, rhs.first, lhs.size()) :
+					                                     (lhs.size() < rhs.size() ? -1 : 1);
+					return lhs.sign ? -r : r;}
+
+				/**
+				* O(1) or O(n) depending on if the sizes differ or are the same respectively
+				* M(1)
+				* @param lhs an IntegerView
+				* @param rhs an Integer
+				* @return negative, zero or positive as lhs is less than, equal to, or greater than rhs
+				*/
+				template <typename T, typename C>
+				friend int compare (const IntegerView& lhs, const Integer<T, C>& rhs) {
+					const bool negative = rhs < Integer<T, C>::ZERO;
+					if(lhs.sign != negative) return lhs.sign ? -1 : 1;
+					int r = 0;
+					if(lhs.size() != rhs.size())
+						r = lhs.size() < rhs.size() ? -1 : 1;
+					else {
+						typename Integer<T, C>::const_iterator j = rhs.begin();
+						for(const char* i = lhs.first; !r && i != lhs.last; ++i, ++j)
+							r = (*i - '0' < *j) ? -1 : (*i - '0' > *j);
+					}
+					return lhs.sign ? -r : r;}
+
+				/**
+				* O(1) or O(n) depending on if the sizes differ or are the same respectively
+				* M(1)
+				* @param lhs an IntegerView
+				* @param rhs an IntegerView
+				* @return true if lhs is equal to rhs
+				*/
+				friend bool operator == (const IntegerView& lhs, const IntegerView& rhs) {
+					return compare(lhs, rhs) == 0;}
+
+				/**
+				* O(1) or O(n) depending on if the sizes differ or are the same respectively
+				* M(1)
+				* @param lhs an IntegerView
+				* @param rhs an IntegerView
+				* @return true if lhs is not equal to rhs
+				*/
+				friend bool operator != (const IntegerView& lhs, const IntegerView& rhs) {
+					return compare(lhs, rhs) != 0;}
+
+				/**
+				* O(1) or O(n) depending on if the sizes differ or are the same respectively
+				* M(1)
+				* @param lhs an IntegerView
+				* @param rhs an IntegerView
+				* @return true if lhs is less than rhs
+				*/
+				friend bool operator < (const IntegerView& lhs, const IntegerView& rhs) {
+					return compare(lhs, rhs) < 0;}
+
+				/**
+				* O(1) or O(n) depending on if the sizes differ or are the same respectively
+				* M(1)
+				* @param lhs an IntegerView
+				* @param rhs an Integer
+				* @return true if lhs is equal to rhs
+				*/
+				template <typename T, typename C>
+				friend bool operator == (const IntegerView& lhs, const Integer<T, C>& rhs) {
+					return compare(lhs, rhs) == 0;}
+
+				/**
+				* O(1) or O(n) depending on if the sizes differ or are the same respectively
+				* M(1)
+				* @param lhs an Integer
+				* @param rhs an IntegerView
+				* @return true if lhs is equal to rhs
+				*/
+				template <typename T, typename C>
+				friend bool operator == (const Integer<T, C>& lhs, const IntegerView& rhs) {
+					return compare(rhs, lhs) == 0;}
+
+				/**
+				* O(1) or O(n) depending on if the sizes differ or are the same respectively
+				* M(1)
+				* @param lhs an IntegerView
+				* @param rhs an Integer
+				* @return true if lhs is not equal to rhs
+				*/
+				template <typename T, typename C>
+				friend bool operator != (const IntegerView& lhs, const Integer<T, C>& rhs) {
+					return compare(lhs, rhs) != 0;}
+
+				/**
+				* O(1) or O(n) depending on if the sizes differ or are the same respectively
+				* M(1)
+				* @param lhs an Integer
+				* @param rhs an IntegerView
+				* @return true if lhs is not equal to rhs
+				*/
+				template <typename T, typename C>
+				friend bool operator != (const Integer<T, C>& lhs, const IntegerView& rhs) {
+					return compare(rhs, lhs) != 0;}
+
+				/**
+				* O(n)
+				* M(1)
+				* @param lhs an ostream
+				* @param rhs an IntegerView
+				* @return the ostream
+				*/
+				friend std::ostream& operator << (std::ostream& lhs, const IntegerView& rhs) {
+					if(rhs.sign) lhs << "-";
+					return lhs.write(rhs.first, rhs.size());}
+
+			public:
+				/**
+				* O(n) to validate the digits, none of which are copied
+				* M(1)
+				* @param path a file holding a number in base 10, optionally surrounded by whitespace
+				* @throws std::invalid_argument
+				* @throws std::system_error
+				*/
+				explicit IntegerView (const std::string& path) throw (std::invalid_argument, std::system_error) :
+						file(path), first(file.begin()), last(file.end()), sign(false) {
+					strip(first, last);
+					if(first < last && '-' == *first){
+						sign = true;
+						++first;
+					}
+					if(first == last) // "" and "-" are NOT valid integers
+						throw std::invalid_argument("IntegerView::IntegerView()");
+					for(const char* i = first; i < last; ++i){
+						if(*i < '0' || *i > '9')
+							throw std::invalid_argument("IntegerView::IntegerView()");
+					}
+					//scoot past leading zeros if there are any, eliminating negative zero
+					while(first < last-1 && '0' == *first) ++first;
+					if('0' == *first) sign = false;}
+
+				/**
+				* O(1)
+				* M(1)
+				* @return the number of digits
+				*/
+				std::size_t size () const {
+					return last - first;}
+
+				/**
+				* O(n)
+				* M(n)
+				* @return a heap allocated copy of the number
+				*/
+				template <typename T, typename C>
+				explicit operator Integer<T, C> () const {
+					typename Integer<T, C>::Parser p(size() + sign);
+					if(sign) p.feed("-", "-" + 1);
+					p.feed(first, last);
+					return p.finish();}
+
+			private:
+				MappedFile file;
+				const char* first;  //most significant digit
+				const char* last;   //one past the least significant digit
+				bool sign;
+			};
+
+			// ----
+			// load
+			// ----
+
+			/**
+			* read an Integer from a file through a memory mapping
+			*/
+
+			/**
+			* O(n)
+			* M(n) the digits go straight from the mapped pages through the Parser, which checks each of them
+			* once, into x's container, reserved up front
+			* @param path a file holding a number in base 10, optionally surrounded by whitespace
+			* @param x receives the number, and is left unchanged if anything is thrown
+			* @throws std::invalid_argument
+			* @throws std::system_error
+			*/
+			template <typename T, typename C>
+				void load (const std::string& path, Integer<T, C>& x) throw (std::invalid_argument, std::system_error) {
+					const MappedFile file(path);
+					const char* first = file.begin();
+					const char* last  = file.end();
+					strip(first, last);
+					typename Integer<T, C>::Parser p(last - first);
+					p.feed(first, last);
+					Integer<T, C> r = p.finish();
+					x.swap(r);}
+
+		} // integer
+	} // prog
+} // alg
+
+#endif // IntegerIO_h
@@ -0,0 +1,599 @@
+// -----------------------
+// integer/IntegerPrime.h
+// Tj Wrenn
+// -----------------------
+
+#ifndef IntegerPrime_h
+#define IntegerPrime_h
+
+// --------
+// includes
+// --------
+
+#include <algorithm>  // fill, max, min, swap
+#include <atomic>     // atomic
+#include <cassert>    // assert
+#include <cstdint>    // uint32_t, uint64_t
+#include <functional> // cref, ref
+#include <future>     // async, future
+#include <thread>     // thread
+#include <vector>     // vector
+
+#include "Integer.h"
+
+// ----------
+// namespaces
+// ----------
+
+namespace alg   {
+	namespace prog    {
+		namespace integer {
+
+			// ------------
+			// small_primes
+			// ------------
+
+			/**
+			* candidates are sieved by the primes below SMALL_PRIME_LIMIT before any bignum work
+			*/
+			const unsigned SMALL_PRIME_LIMIT = 1 << 14;
+
+			/**
+			* O(1) after the first call, which sieves
+			* M(1) after the first call
+			* @return the primes below SMALL_PRIME_LIMIT in increasing order
+			*/
+			inline const std::vector<unsigned>& small_primes () {
+				struct sieve {
+					static std::vector<unsigned> run () {
+						std::vector<bool> composite(SMALL_PRIME_LIMIT);
+						std::vector<unsigned> primes;
+						for(unsigned p=2; p<SMALL_PRIME_LIMIT; ++p){
+							if(composite[p]) continue;
+							primes.push_back(p);
+							for(unsigned q=p*p; q<SMALL_PRIME_LIMIT; q+=p)
+								composite[q] = true;
+						}
+						return primes;}
+				};
+				static const std::vector<unsigned> primes = sieve::run();
+				return primes;}
+
+			// ------
+			// jacobi
+			// ------
+
+			/**
+			* O(log n)
+			* M(1)
+			* @param a a word
+			* @param n an odd word
+			* @return the Jacobi symbol (a/n)
+			*/
+			inline int jacobi (unsigned long long a, unsigned long long n) {
+				assert(n & 1);
+				int j = 1;
+				a %= n;
+				while(a){
+					while(!(a & 1)){
+						a >>= 1;
+						if((n & 7) == 3 || (n & 7) == 5) j = -j;
+					}
+					std::swap(a, n);
+					if((a & 3) == 3 && (n & 3) == 3) j = -j;
+					a %= n;
+				}
+				return n == 1 ? j : 0;}
+
+			// -----
+			// limbs
+			// -----
+
+			/**
+			* O(L)
+			* M(1)
+			* @param a a number in 32 bit limbs, least significant first
+			* @param m a positive word
+			* @return a mod m
+			*/
+			inline std::uint32_t limbs_modulo (const std::vector<std::uint32_t>& a, std::uint32_t m) {
+				std::uint64_t r = 0;
+				for(std::size_t i=a.size(); i--; )
+					r = ((r << 32) | a[i]) % m;
+				return std::uint32_t(r);}
+
+			/**
+			* O(L)
+			* M(L)
+			* @param a a number in 32 bit limbs, least significant first
+			* @param w a word
+			* @return a + w in limbs
+			*/
+			inline std::vector<std::uint32_t> limbs_plus (std::vector<std::uint32_t> a, std::uint32_t w) {
+				std::uint64_t carry = w;
+				for(std::size_t i=0; carry && i<a.size(); ++i){
+					const std::uint64_t s = std::uint64_t(a[i]) + carry;
+					a[i] = std::uint32_t(s);
+					carry = s >> 32;
+				}
+				if(carry) a.push_back(std::uint32_t(carry));
+				return a;}
+
+			/**
+			* O(L)
+			* M(1)
+			* @param primes the primes to take residues by, in increasing order, each below 2^16
+			* @param a a number in 32 bit limbs, least significant first
+			* @param residues set to a mod each prime, a batch of primes at a time against the residue of their
+			* product, which fits in a limb
+			*/
+			inline void limbs_residues (const std::vector<unsigned>& primes, const std::vector<std::uint32_t>& a, std::vector<unsigned>& residues) {
+				residues.resize(primes.size());
+				for(std::size_t i=0; i<primes.size(); ){
+					std::size_t k = i;
+					std::uint32_t product = 1;
+					for(; k<primes.size() && product <= 0xffffffffu / primes[k]; ++k)
+						product *= primes[k];
+					const std::uint32_t r = limbs_modulo(a, product);
+					for(; i<k; ++i)
+						residues[i] = r % primes[i];
+				}}
+
+			// ----------
+			// Montgomery
+			// ----------
+
+			/**
+			* arithmetic modulo an odd number held in 32 bit limbs, least significant first.  Every residue
+			* is kept multiplied by R = 2^(32*L), L the number of limbs of the modulus, so that reducing a
+			* product costs a multiplication and a shift rather than a long division.
+			*/
+			class Montgomery {
+				public:
+					typedef std::uint32_t     limb;
+					typedef std::vector<limb> limbs;
+
+				private:
+					limbs n;   //the modulus
+					limb  q;   //-1/n mod 2^32
+					limbs r1;  //R mod n, which is 1 in Montgomery form
+					limbs r2;  //R^2 mod n, which takes a residue into Montgomery form
+
+					/**
+					* O(L)
+					* M(1)
+					* @return true if a, which has L limbs, is at least the modulus
+					*/
+					bool atLeastModulus (const limbs& a) const {
+						for(std::size_t i=n.size(); i--; ){
+							if(a[i] != n[i]) return a[i] > n[i];
+						}
+						return true;}
+
+					/**
+					* O(L)
+					* M(1)
+					* a -= n, dropping the final borrow
+					*/
+					void subtractModulus (limbs& a) const {
+						std::uint64_t borrow = 0;
+						for(std::size_t i=0; i<n.size(); ++i){
+							const std::uint64_t d = std::uint64_t(a[i]) - n[i] - borrow;
+							a[i] = limb(d);
+							borrow = (d >> 32) & 1;
+						}}
+
+				public:
+					/**
+					* O(L^2)
+					* M(L)
+					* @param m an odd modulus greater than one, without leading zero limbs
+					*/
+					explicit Montgomery (const limbs& m) : n(m) {
+						assert(!n.empty() && (n[0] & 1) && n.back() && (n.size() > 1 || n[0] > 1));
+
+						//Newton's iteration for 1/n mod 2^32, from a start that is correct to 3 bits
+						limb inv = n[0];
+						for(int i=0; i<4; ++i)
+							inv *= 2 - n[0]*inv;
+						q = 0 - inv;
+
+						//double 1 up to R and then on to R^2
+						r1.assign(n.size(), 0);
+						r1[0] = 1;
+						for(std::size_t i=0; i<32*n.size(); ++i)
+							r1 = add(r1, r1);
+						r2 = r1;
+						for(std::size_t i=0; i<32*n.size(); ++i)
+							r2 = add(r2, r2);}
+
+					/**
+					* O(L)
+					* M(1)
+					* @param m a positive word
+					* @return the modulus reduced modulo m
+					*/
+					limb residue (limb m) const {
+						return limbs_modulo(n, m);}
+
+					/**
+					* @return 0 in Montgomery form
+					*/
+					limbs zero () const {
+						return limbs(n.size(), 0);}
+
+					/**
+					* @return 1 in Montgomery form
+					*/
+					const limbs& one () const {
+						return r1;}
+
+					/**
+					* O(L^2)
+					* M(L)
+					* @param v a word smaller than the modulus
+					* @return v in Montgomery form
+					*/
+					limbs fromSmall (limb v) const {
+						limbs a(n.size(), 0);
+						a[0] = v;
+						return mul(a, r2);}
+
+					/**
+					* O(L)
+					* M(L)
+					* @return a + b mod n
+					*/
+					limbs add (const limbs& a, const limbs& b) const {
+						limbs r(n.size());
+						std::uint64_t carry = 0;
+						for(std::size_t i=0; i<n.size(); ++i){
+							const std::uint64_t s = std::uint64_t(a[i]) + b[i] + carry;
+							r[i] = limb(s);
+							carry = s >> 32;
+						}
+						if(carry || atLeastModulus(r)) subtractModulus(r);
+						return r;}
+
+					/**
+					* O(L)
+					* M(L)
+					* @return a - b mod n
+					*/
+					limbs sub (const limbs& a, const limbs& b) const {
+						limbs r(n.size());
+						std::uint64_t borrow = 0;
+						for(std::size_t i=0; i<n.size(); ++i){
+							const std::uint64_t d = std::uint64_t(a[i]) - b[i] - borrow;
+							r[i] = limb(d);
+							borrow = (d >> 32) & 1;
+						}
+						if(borrow){
+							std::uint64_t carry = 0;
+							for(std::size_t i=0; i<n.size(); ++i){
+								const std::uint64_t s = std::uint64_t(r[i]) + n[i] + carry;
+								r[i] = limb(s);
+								carry = s >> 32;
+							}
+						}
+						return r;}
+
+					/**
+					* O(L)
+					* M(L)
+					* @return a / 2 mod n
+					*/
+					limbs half (const limbs& a) const {
+						limbs r(a);
+						std::uint64_t carry = 0;
+						if(a[0] & 1){
+							for(std::size_t i=0; i<n.size(); ++i){
+								const std::uint64_t s = std::uint64_t(r[i]) + n[i] + carry;
+								r[i] = limb(s);
+								carry = s >> 32;
+							}
+						}
+						for(std::size_t i=0; i<n.size(); ++i){
+							const limb top = i+1 < n.size() ? r[i+1] : limb(carry);
+							r[i] = (r[i] >> 1) | (top << 31);
+						}
+						return r;}
+
+					/**
+					* O(L^2)
+					* M(L)
+					* interleaves the schoolbook product with the reduction, one limb of b at a time
+					* @return a * b / R mod n, which is the Montgomery form of the product
+					*/
+					limbs mul (const limbs& a, const limbs& b) const {
+						const std::size_t L = n.size();
+						limbs t(L+2, 0);
+						for(std::size_t i=0; i<L; ++i){
+							std::uint64_t c = 0;
+							for(std::size_t j=0; j<L; ++j){
+								const std::uint64_t s = std::uint64_t(a[j])*b[i] + t[j] + c;
+								t[j] = limb(s);
+								c = s >> 32;
+							}
+							std::uint64_t s = std::uint64_t(t[L]) + c;
+							t[L] = limb(s);
+							t[L+1] = limb(s >> 32);
+
+							//add the multiple of n that clears the lowest limb, then drop that limb
+							const limb m = t[0]*q;
+							c = (std::uint64_t(m)*n[0] + t[0]) >> 32;
+							for(std::size_t j=1; j<L; ++j){
+								s = std::uint64_t(m)*n[j] + t[j] + c;
+								t[j-1] = limb(s);
+								c = s >> 32;
+							}
+							s = std::uint64_t(t[L]) + c;
+							t[L-1] = limb(s);
+							t[L] = t[L+1] + limb(s >> 32);
+						}
+						limbs r(t.begin(), t.begin()+L);
+						if(t[L] || atLeastModulus(r)) subtractModulus(r);
+						return r;}
+
+					/**
+					* O(L^2 log e), taking four bits of the exponent per multiplication
+					* M(L) for a table of sixteen powers
+					* @param a a residue in Montgomery form
+					* @param e the exponent in limbs, least significant first
+					* @return a^e in Montgomery form
+					*/
+					limbs pow (const limbs& a, const limbs& e) const {
+						std::vector<limbs> table(16);
+						table[0] = r1;
+						for(std::size_t k=1; k<16; ++k)
+							table[k] = mul(table[k-1], a);
+
+						limbs r = r1;
+						bool started = false;
+						for(std::size_t i=8*e.size(); i--; ){
+							const limb nibble = (e[i/8] >> (4*(i%8))) & 15;
+							if(started){
+								for(int k=0; k<4; ++k)
+									r = mul(r, r);
+							}
+							if(nibble){
+								r = started ? mul(r, table[nibble]) : table[nibble];
+								started = true;
+							}
+						}
+						return r;}
+
+					/**
+					* O(1)
+					* M(1)
+					* @return bit i of the number held in e
+					*/
+					static bool bit (const limbs& e, std::size_t i) {
+						return i/32 < e.size() && ((e[i/32] >> (i%32)) & 1);}
+
+					/**
+					* O(L)
+					* M(L)
+					* @return the number held in e divided by 2^k
+					*/
+					static limbs shifted (const limbs& e, std::size_t k) {
+						limbs r(e.begin() + std::min(k/32, e.size()), e.end());
+						if(k %= 32){
+							for(std::size_t i=0; i<r.size(); ++i)
+								r[i] = (r[i] >> k) | (i+1 < r.size() ? r[i+1] << (32-k) : 0);
+						}
+						if(r.empty()) r.push_back(0);
+						return r;}
+			};
+
+			// ----
+			// bpsw
+			// ----
+
+			/**
+			* Baillie-PSW test
+			*/
+
+			/**
+			* O(M(n) log n) for a strong Fermat test to base 2 followed by a strong Lucas test with
+			* Selfridge's parameters, both in Montgomery form.  No composite is known to pass both,
+			* and none below 2^64 does.
+			* M(n)
+			* @param x an odd Integer above 10^6 with no prime factor below 1000
+			* @param n the magnitude of x in limbs, least significant first, without leading zero limbs
+			* @return false if x is composite, true if x is a probable prime
+			*/
+			template <typename T, typename C>
+				bool bpsw (const Integer<T, C>& x, const Montgomery::limbs& n) {
+					typedef Montgomery::limbs limbs;
+					const Montgomery m(n);
+					const limbs zero = m.zero();
+					const limbs minusOne = m.sub(zero, m.one());
+
+					//n-1 == d*2^s
+					limbs d = n;
+					--d[0];
+					std::size_t s = 1;
+					while(!Montgomery::bit(d, s)) ++s;
+					limbs y = m.pow(m.fromSmall(2), Montgomery::shifted(d, s));
+					if(y != m.one() && y != minusOne){
+						std::size_t r = 1;
+						for(; r<s; ++r){
+							y = m.mul(y, y);
+							if(y == minusOne) break;
+						}
+						if(r == s) return false;
+					}
+
+					//the first D in 5, -7, 9, -11, ... with (D/n) == -1, which never comes if n is a square
+					long long D = 5;
+					for(int tries=1; ; ++tries){
+						const unsigned long long a = D < 0 ? -D : D;
+						//(D/n) from (n mod |D| / |D|) by reciprocity
+						int j = jacobi(m.residue(static_cast<Montgomery::limb>(a)), a);
+						if((a & 3) == 3 && (n[0] & 3) == 3) j = -j;
+						if(D < 0 && (n[0] & 3) == 3) j = -j;
+						if(j == 0) return false;
+						if(j == -1) break;
+						if(tries == 8 && is_square(x)) return false;
+						D = D < 0 ? 2-D : -2-D;
+					}
+					const long long Q = (1-D)/4;
+					const limbs mD = D < 0 ? m.sub(zero, m.fromSmall(static_cast<Montgomery::limb>(-D))) : m.fromSmall(static_cast<Montgomery::limb>(D));
+					const limbs mQ = Q < 0 ? m.sub(zero, m.fromSmall(static_cast<Montgomery::limb>(-Q))) : m.fromSmall(static_cast<Montgomery::limb>(Q));
+
+					//n+1 == k*2^t
+					limbs k = n;
+					std::size_t i = 0;
+					while(i < k.size() && !++k[i]) ++i;
+					if(i == k.size()) k.push_back(1);
+					std::size_t t = 1;
+					while(!Montgomery::bit(k, t)) ++t;
+					k = Montgomery::shifted(k, t);
+
+					//U_k, V_k and Q^k of the Lucas sequences with P == 1, from the top bit of k down
+					std::size_t bits = 32*k.size();
+					while(!Montgomery::bit(k, bits-1)) --bits;
+					limbs U = m.one();
+					limbs V = m.one();
+					limbs Qk = mQ;
+					for(std::size_t b=bits-1; b--; ){
+						U = m.mul(U, V);
+						V = m.sub(m.mul(V, V), m.add(Qk, Qk));
+						Qk = m.mul(Qk, Qk);
+						if(Montgomery::bit(k, b)){
+							const limbs u = m.half(m.add(U, V));
+							V = m.half(m.add(m.mul(mD, U), V));
+							U = u;
+							Qk = m.mul(Qk, mQ);
+						}
+					}
+					if(U == zero || V == zero) return true;
+					for(std::size_t r=1; r<t; ++r){
+						V = m.sub(m.mul(V, V), m.add(Qk, Qk));
+						if(V == zero) return true;
+						Qk = m.mul(Qk, Qk);
+					}
+					return false;}
+
+			// -----------------
+			// is_probable_prime
+			// -----------------
+
+			/**
+			* primality test
+			*/
+
+			/**
+			* O(n^2) word operations to reach limbs, O(n) trial division by the primes below 1000, then
+			* O(M(n) log n) for bpsw
+			* M(n)
+			* @param x an Integer
+			* @return true if x is prime, which is certain below 2^64 and probable, with no known exception, above
+			*/
+			template <typename T, typename C>
+				bool is_probable_prime (const Integer<T, C>& x) {
+					if(x <= Integer<T, C>::ONE) return false;
+					const Montgomery::limbs n = x.to_limbs();
+
+					//test a batch of small primes against the residue of their product, which fits in a limb
+					const std::vector<unsigned>& primes = small_primes();
+					for(std::size_t i=0; primes[i] < 1000; ){
+						std::size_t k = i;
+						std::uint32_t product = 1;
+						for(; primes[k] < 1000 && product <= 0xffffffffu / primes[k]; ++k)
+							product *= primes[k];
+						const std::uint32_t r = limbs_modulo(n, product);
+						for(; i<k; ++i){
+							if(r % primes[i] == 0) return n.size() == 1 && n[0] == primes[i];
+						}
+					}
+
+					//below 1000^2, having no prime factor below 1000 is enough
+					if(x.size() <= 6) return true;
+					return bpsw(x, n);}
+
+			// ----------
+			// next_prime
+			// ----------
+
+			/**
+			* O(M(n) log n) per candidate
+			* M(n)
+			* takes the candidates of a window in increasing order until one is found to be prime, so that
+			* every candidate below the smallest prime found has been tested by some thread
+			*/
+			template <typename T, typename C>
+				void next_prime_worker (const Integer<T, C>& base, const Montgomery::limbs& limbs, const std::vector<unsigned>& survivors,
+				                        std::atomic<std::size_t>& next, std::atomic<std::size_t>& found) {
+					for(;;){
+						const std::size_t i = next++;
+						if(i >= found) return;
+						if(bpsw(base + Integer<T, C>(static_cast<int>(survivors[i])), limbs_plus(limbs, survivors[i]))){
+							std::size_t f = found;
+							while(i < f && !found.compare_exchange_weak(f, i));
+						}
+					}}
+
+			/**
+			* O(M(n) log n) for each candidate that survives sieving by the primes below SMALL_PRIME_LIMIT,
+			* with the survivors of each window tested in parallel
+			* M(n) per thread
+			* @param x an Integer
+			* @return the smallest prime greater than x
+			*/
+			template <typename T, typename C>
+				Integer<T, C> next_prime (const Integer<T, C>& x) {
+					typedef Integer<T, C> integer;
+					if(x <= integer::ONE) return integer(2);
+					if(x.size() <= 6){
+						integer c = x;
+						do ++c; while(!is_probable_prime(c));
+						return c;
+					}
+
+					//a window spans about thirty average prime gaps, which grow by 2.3 per digit
+					const unsigned window = 64*static_cast<unsigned>(x.size());
+					const std::vector<unsigned>& primes = small_primes();
+					integer base = x + integer::ONE;
+					Montgomery::limbs limbs = base.to_limbs();
+
+					//base mod each sieving prime
+					std::vector<unsigned> residues;
+					limbs_residues(primes, limbs, residues);
+
+					const unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+					std::vector<char> composite(window);
+					for(;;){
+						//base is above every sieving prime, so no prime is struck out as a multiple of itself
+						std::fill(composite.begin(), composite.end(), 0);
+						for(std::size_t i=0; i<primes.size(); ++i){
+							const unsigned p = primes[i];
+							for(unsigned o=(p - residues[i]) % p; o<window; o+=p)
+								composite[o] = 1;
+							residues[i] = (residues[i] + window) % p;
+						}
+						std::vector<unsigned> survivors;
+						for(unsigned o=0; o<window; ++o){
+							if(!composite[o]) survivors.push_back(o);
+						}
+
+						std::atomic<std::size_t> next(0);
+						std::atomic<std::size_t> found(survivors.size());
+						std::vector< std::future<void> > workers;
+						for(unsigned w=1; w<threads; ++w)
+							workers.push_back(std::async(std::launch::async, &next_prime_worker<T, C>, std::cref(base), std::cref(limbs), std::cref(survivors), std::ref(next), std::ref(found)));
+						next_prime_worker(base, limbs, survivors, next, found);
+						for(std::size_t w=0; w<workers.size(); ++w)
+							workers[w].get();
+
+						if(found < survivors.size()) return base + integer(static_cast<int>(survivors[found]));
+						base += integer(static_cast<int>(window));
+						limbs = limbs_plus(limbs, window);
+					}}
+
+		} // integer
+	} // prog
+} // alg
+
+#endif // IntegerPrime_h
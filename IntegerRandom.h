@@ -0,0 +1,262 @@
+// ------------------------
+// integer/IntegerRandom.h
+// Tj Wrenn
+// ------------------------
+
+#ifndef IntegerRandom_h
+#define IntegerRandom_h
+
+// --------
+// includes
+// --------
+
+#include <algorithm>  // max, min
+#include <atomic>     // atomic
+#include <cstddef>    // size_t
+#include <cstdint>    // uint32_t, uint64_t
+#include <functional> // cref, ref
+#include <future>     // async, future
+#include <iterator>   // distance
+#include <random>     // mt19937_64, seed_seq, uniform_int_distribution
+#include <stdexcept>  // invalid_argument
+#include <thread>     // thread
+#include <vector>     // vector
+
+#include "Integer.h"
+
+// ----------
+// namespaces
+// ----------
+
+namespace alg   {
+	namespace prog    {
+		namespace integer {
+
+			// ------------
+			// random words
+			// ------------
+
+			/**
+			* random digits are drawn this many at a time, from a word below 10^RANDOM_CHUNK
+			*/
+			const std::size_t RANDOM_CHUNK = 18;
+
+			/**
+			* O(k)
+			* M(1)
+			* @return 10^k, for k no more than 19
+			*/
+			inline std::uint64_t random_tens (std::size_t k) {
+				std::uint64_t r = 1;
+				while(k--) r *= 10;
+				return r;}
+
+			/**
+			* O(1)
+			* M(1)
+			* @param g a uniform random bit generator
+			* @return 64 uniformly random bits, taken straight from g when it yields 32 or 64 bits a call
+			*/
+			template <typename G>
+				std::uint64_t random_word (G& g) {
+					const std::uint64_t lo = G::min();
+					const std::uint64_t hi = G::max();
+					if(lo == 0 && hi == ~std::uint64_t(0))
+						return g();
+					if(lo == 0 && hi == 0xffffffffu){
+						const std::uint64_t high = g();
+						return high << 32 | std::uint64_t(g());
+					}
+					return std::uniform_int_distribution<std::uint64_t>()(g);}
+
+			/**
+			* O(1) expected, as fewer than half the words drawn are ever rejected
+			* M(1)
+			* @param g a uniform random bit generator
+			* @param n a positive bound
+			* @return a uniformly random number below n; the 2^64 % n smallest words are rejected, which
+			* leaves a multiple of n words for % to share out evenly
+			*/
+			template <typename G>
+				std::uint64_t random_word_below (G& g, std::uint64_t n) {
+					const std::uint64_t skip = (0 - n) % n;
+					std::uint64_t w;
+					do w = random_word(g); while(w < skip);
+					return w % n;}
+
+			/**
+			* O(k)
+			* M(1)
+			* writes the k lowest digits of w into c from index at up, least significant first
+			*/
+			template <typename T>
+				void random_put_digits (std::vector<T>& c, std::size_t at, std::uint64_t w, std::size_t k) {
+					for(; k; --k, ++at, w /= 10)
+						c[at] = static_cast<T>(w % 10);}
+
+			/**
+			* O(k)
+			* M(1)
+			* @return the number formed by the k digits of x from index at up, counting from the least significant
+			*/
+			template <typename T, typename C>
+				std::uint64_t random_get_digits (const Integer<T, C>& x, std::size_t at, std::size_t k) {
+					std::uint64_t w = 0;
+					while(k--)
+						w = w*10 + x[at + k];
+					return w;}
+
+			// -----------
+			// random_bits
+			// -----------
+
+			/**
+			* O(n) words drawn from g, then O(n^2) word operations to reach base 10
+			* M(n)
+			* @param n the number of bits
+			* @param g a uniform random bit generator
+			* @return a uniformly random Integer<T, C> in [0, 2^n)
+			*/
+			template <typename T, typename C = std::vector<T>, typename G>
+				Integer<T, C> random_bits (std::size_t n, G& g) {
+					std::vector<std::uint32_t> limbs((n + 31)/32 + !n, 0);
+					for(std::size_t i=0; 32*i < n; i+=2){
+						const std::uint64_t w = random_word(g);
+						limbs[i] = std::uint32_t(w);
+						if(i+1 < limbs.size()) limbs[i+1] = std::uint32_t(w >> 32);
+					}
+					if(n % 32) limbs.back() &= (std::uint32_t(1) << n % 32) - 1;
+					while(limbs.size() > 1 && !limbs.back()) limbs.pop_back();
+					return Integer<T, C>::from_limbs(limbs);}
+
+			// -------------
+			// random_digits
+			// -------------
+
+			/**
+			* O(n), one word drawn from g per RANDOM_CHUNK digits
+			* M(n)
+			* @param n the number of digits, at least one
+			* @param g a uniform random bit generator
+			* @return a uniformly random Integer<T, C> of exactly n digits, in [10^(n-1), 10^n)
+			* @throws std::invalid_argument if n is zero
+			*/
+			template <typename T, typename C = std::vector<T>, typename G>
+				Integer<T, C> random_digits (std::size_t n, G& g) throw (std::invalid_argument) {
+					if(!n) throw std::invalid_argument("random_digits()");
+					std::vector<T> digits(n);
+					std::size_t at = 0;
+					for(; n - at > RANDOM_CHUNK; at += RANDOM_CHUNK)
+						random_put_digits(digits, at, random_word_below(g, random_tens(RANDOM_CHUNK)), RANDOM_CHUNK);
+					const std::uint64_t low = random_tens(n - at - 1);
+					random_put_digits(digits, at, low + random_word_below(g, 9*low), n - at);
+					return Integer<T, C>::from_digits(digits.begin(), digits.end());}
+
+			// ------------
+			// random_below
+			// ------------
+
+			/**
+			* O(n) expected, one word drawn from g per RANDOM_CHUNK digits
+			* M(n)
+			* the leading RANDOM_CHUNK digits are drawn below those of bound, and each later chunk is compared
+			* with bound's only while all those above it are equal, so that a draw is rejected with odds below
+			* 10^-17 and usually after its first word
+			* @param bound a positive Integer
+			* @param g a uniform random bit generator
+			* @return a uniformly random Integer in [0, bound)
+			* @throws std::invalid_argument if bound is not positive
+			*/
+			template <typename T, typename C, typename G>
+				Integer<T, C> random_below (const Integer<T, C>& bound, G& g) throw (std::invalid_argument) {
+					if(bound <= Integer<T, C>::ZERO) throw std::invalid_argument("random_below()");
+					const Integer<T, C> max = bound - Integer<T, C>::ONE;
+					const std::size_t n = max.size();
+					std::vector<T> digits(n);
+					for(bool rejected = true; rejected; ){
+						std::size_t k = std::min(n, RANDOM_CHUNK);
+						std::size_t at = n - k;
+						std::uint64_t w = random_word_below(g, random_get_digits(max, at, k) + 1);
+						random_put_digits(digits, at, w, k);
+						bool tight = w == random_get_digits(max, at, k);
+						rejected = false;
+						while(at && !rejected){
+							k = std::min(at, RANDOM_CHUNK);
+							at -= k;
+							w = random_word_below(g, random_tens(k));
+							random_put_digits(digits, at, w, k);
+							if(tight){
+								const std::uint64_t b = random_get_digits(max, at, k);
+								rejected = w > b;
+								tight = w == b;
+							}
+						}
+					}
+					return Integer<T, C>::from_digits(digits.begin(), digits.end());}
+
+			// ---------------
+			// generate_random
+			// ---------------
+
+			/**
+			* generate_random hands each block of this many elements its own stream
+			*/
+			const std::size_t RANDOM_BLOCK = 64;
+
+			/**
+			* O(1) plus seeding
+			* M(1)
+			* @param seed the seed shared by every stream of a run
+			* @param stream the number of the stream
+			* @return an engine that yields the same sequence for the same seed and stream on every run, unrelated
+			* to the sequence of any other seed or stream
+			*/
+			inline std::mt19937_64 random_stream (std::uint64_t seed, std::uint64_t stream) {
+				std::seed_seq s{std::uint32_t(seed), std::uint32_t(seed >> 32), std::uint32_t(stream), std::uint32_t(stream >> 32)};
+				return std::mt19937_64(s);}
+
+			/**
+			* takes blocks of [first, first+n) in increasing order, filling block b from random_stream(seed, b)
+			*/
+			template <typename RI, typename F>
+				void generate_random_worker (RI first, std::size_t n, std::uint64_t seed, const F& f, std::atomic<std::size_t>& next) {
+					for(;;){
+						const std::size_t b = next++;
+						if(b*RANDOM_BLOCK >= n) return;
+						std::mt19937_64 g = random_stream(seed, b);
+						for(std::size_t i = b*RANDOM_BLOCK; i < std::min(n, (b+1)*RANDOM_BLOCK); ++i)
+							first[i] = f(g);
+					}}
+
+			/**
+			* O(n) calls of f, spread over every core or over threads
+			* M(1) beyond what f makes
+			* fills [first, last) with f(g), where g is the std::mt19937_64 of the RANDOM_BLOCK elements around
+			* each one; block b draws from random_stream(seed, b), so the values depend only on seed and f, never
+			* on the number of threads
+			* @param first a random access iterator to the first element
+			* @param last one past the last element
+			* @param seed the seed of every stream
+			* @param f a function object, such as one calling random_digits, which may be called from
+			* several threads at once
+			* @param threads the most threads to fill blocks on, or 0 for one per core
+			*/
+			template <typename RI, typename F>
+				void generate_random (RI first, RI last, std::uint64_t seed, F f, unsigned threads = 0) {
+					const std::size_t n = static_cast<std::size_t>(std::distance(first, last));
+					const std::size_t blocks = (n + RANDOM_BLOCK - 1) / RANDOM_BLOCK;
+					if(!threads) threads = std::max(1u, std::thread::hardware_concurrency());
+					threads = static_cast<unsigned>(std::min<std::size_t>(blocks, threads));
+					std::atomic<std::size_t> next(0);
+					std::vector< std::future<void> > workers;
+					for(unsigned w=1; w<threads; ++w)
+						workers.push_back(std::async(std::launch::async, &generate_random_worker<RI, F>, first, n, seed, std::cref(f), std::ref(next)));
+					generate_random_worker(first, n, seed, f, next);
+					for(std::size_t w=0; w<workers.size(); ++w)
+						workers[w].get();}
+
+		} // integer
+	} // prog
+} // alg
+
+#endif // IntegerRandom_h
@@ -0,0 +1,364 @@
+// -------------------
+// integer/Rational.h
+// Tj Wrenn
+// -------------------
+
+#ifndef Rational_h
+#define Rational_h
+
+// --------
+// includes
+// --------
+
+#include <cstddef>     // size_t
+#include <iostream>    // ostream
+#include <stdexcept>   // invalid_argument
+#include <type_traits> // false_type, true_type
+
+#include "Integer.h"
+
+// ----------
+// namespaces
+// ----------
+
+namespace alg   {
+	namespace prog    {
+		namespace integer {
+
+			// ------------
+			// FixedInteger
+			// ------------
+
+			/**
+			* defined in FixedInteger.h, which needs C++14 and so is left for its users to include
+			*/
+			template <std::size_t Bits, typename Overflow>
+			class FixedInteger;
+
+			// -------------------
+			// is_rational_integer
+			// -------------------
+
+			/**
+			* true for the I that a Rational<I> can be made of: Integer<T, C> and FixedInteger<Bits, Overflow>
+			*/
+			template <typename I>
+			struct is_rational_integer : std::false_type {};
+
+			template <typename T, typename C>
+			struct is_rational_integer< Integer<T, C> > : std::true_type {};
+
+			template <std::size_t Bits, typename Overflow>
+			struct is_rational_integer< FixedInteger<Bits, Overflow> > : std::true_type {};
+
+			// --------
+			// Rational
+			// --------
+
+			/**
+			* a fraction of two I, where I is Integer<T, C> or FixedInteger<Bits, Overflow>; the gcds and the
+			* exact divisions are done by I's own gcd and operator /.  The denominator is always positive.
+			* A reduced Rational has coprime numerator and denominator, and +, -, * and / of reduced operands
+			* keep it that way by Henrici's methods, which take their gcds of the denominators and of the
+			* small cofactors rather than of the full numerator and denominator of the result.
+			* Normalisation can also be deferred: Rationals made by unreduced(n, d), and everything computed
+			* from one, are combined by plain cross multiplication without any gcd until normalize() is called.
+			* Comparisons and output are correct either way.
+			*/
+			template <typename I>
+			class Rational {
+				static_assert(is_rational_integer<I>::value, "Rational<I> needs I to be Integer<T, C> or FixedInteger<Bits, Overflow>");
+
+				// -----------
+				// comparisons
+				// -----------
+
+				/**
+				* O(1) if both are reduced and unequal in sign or denominator, otherwise O(n^1.585)
+				* M(n)
+				*/
+				friend bool operator == (const Rational& lhs, const Rational& rhs) {
+					if(lhs.reduced && rhs.reduced)
+						return lhs.num == rhs.num && lhs.den == rhs.den;
+					if(lhs.den == rhs.den)
+						return lhs.num == rhs.num;
+					return lhs.num * rhs.den == rhs.num * lhs.den;}
+
+				friend bool operator != (const Rational& lhs, const Rational& rhs) {
+					return !(lhs == rhs);}
+
+				/**
+				* O(1) if lhs and rhs differ in sign, O(n) if they share a denominator, otherwise O(n^1.585)
+				* M(n)
+				*/
+				friend bool operator < (const Rational& lhs, const Rational& rhs) {
+					const I zero(0);
+					const bool l = lhs.num < zero;
+					const bool r = rhs.num < zero;
+					if(l != r)
+						return l;
+					if(lhs.den == rhs.den)
+						return lhs.num < rhs.num;
+					return lhs.num * rhs.den < rhs.num * lhs.den;}
+
+				friend bool operator <= (const Rational& lhs, const Rational& rhs) {
+					return !(rhs < lhs);}
+
+				friend bool operator > (const Rational& lhs, const Rational& rhs) {
+					return rhs < lhs;}
+
+				friend bool operator >= (const Rational& lhs, const Rational& rhs) {
+					return !(lhs < rhs);}
+
+				// ----------
+				// arithmetic
+				// ----------
+
+				friend Rational operator - (const Rational& x) {
+					return Rational(-x.num, x.den, x.reduced);}
+
+				friend Rational operator + (Rational lhs, const Rational& rhs) {
+					return lhs += rhs;}
+
+				friend Rational operator - (Rational lhs, const Rational& rhs) {
+					return lhs -= rhs;}
+
+				friend Rational operator * (Rational lhs, const Rational& rhs) {
+					return lhs *= rhs;}
+
+				friend Rational operator / (Rational lhs, const Rational& rhs) throw (std::invalid_argument) {
+					return lhs /= rhs;}
+
+				// -----------
+				// operator <<
+				// -----------
+
+				/**
+				* writes n/d in lowest terms, or n alone if d is 1
+				*/
+				friend std::ostream& operator << (std::ostream& lhs, const Rational& rhs) {
+					if(!rhs.reduced)
+						return lhs << Rational(rhs).normalize();
+					lhs << rhs.num;
+					if(rhs.den != I(1))
+						lhs << "/" << rhs.den;
+					return lhs;}
+
+				private:
+					// ----
+					// data
+					// ----
+
+					I    num;
+					I    den;      //always positive
+					bool reduced;  //num and den are known to be coprime
+
+					/**
+					* O(1)
+					* M(1)
+					*/
+					Rational (const I& n, const I& d, bool r) : num(n), den(d), reduced(r) {
+						if(num == I(0)) {
+							den     = I(1);
+							reduced = true;}}
+
+					/**
+					* @param n the numerator
+					* @param d the denominator, not zero
+					* @param r whether n and d are known to be coprime
+					* @return n/d with a positive denominator
+					* @throws invalid_argument if d is zero
+					*/
+					static Rational make (I n, I d, bool r) throw (std::invalid_argument) {
+						const I zero(0);
+						if(d == zero)
+							throw std::invalid_argument("Rational()");
+						if(d < zero) {
+							n = -n;
+							d = -d;}
+						return Rational(n, d, r);}
+
+				public:
+					// ------------
+					// constructors
+					// ------------
+
+					/**
+					* O(1)
+					* M(1)
+					* @param n the numerator, over a denominator of 1
+					*/
+					Rational (const I& n = I(0)) : num(n), den(1), reduced(true) {}
+
+					/**
+					* O(n^2) for the gcd
+					* M(n)
+					* @param n the numerator
+					* @param d the denominator, not zero
+					* @throws invalid_argument if d is zero
+					*/
+					Rational (const I& n, const I& d) throw (std::invalid_argument) : num(0), den(1), reduced(true) {
+						*this = make(n, d, false).normalize();}
+
+					/**
+					* O(1)
+					* M(1)
+					* @param n the numerator
+					* @param d the denominator, not zero
+					* @return n/d, to be left unreduced until normalize() is called
+					* @throws invalid_argument if d is zero
+					*/
+					static Rational unreduced (const I& n, const I& d) throw (std::invalid_argument) {
+						return make(n, d, false);}
+
+					// Default copy, destructor, and copy assignment.
+					// Rational (const Rational&);
+					// ~Rational ();
+					// Rational& operator = (const Rational&);
+
+					// ---------
+					// accessors
+					// ---------
+
+					const I& numerator () const {
+						return num;}
+
+					/**
+					* @return the denominator, which is always positive
+					*/
+					const I& denominator () const {
+						return den;}
+
+					/**
+					* @return true if the numerator and denominator are known to be coprime
+					*/
+					bool is_reduced () const {
+						return reduced;}
+
+					// ---------
+					// normalize
+					// ---------
+
+					/**
+					* O(n^2) for the gcd if this is not already reduced, otherwise O(1)
+					* M(n)
+					* divides the numerator and denominator by their gcd; the results of later operations on this are
+					* kept reduced
+					*/
+					Rational& normalize () {
+						if(!reduced) {
+							const I g = gcd(abs(num), den);
+							if(g != I(1)) {
+								num /= g;
+								den /= g;}
+							reduced = true;}
+						return *this;}
+
+					// -----------
+					// operator +=
+					// -----------
+
+					/**
+					* O(n^2) for the gcds when both are reduced, otherwise O(n^1.585)
+					* M(n)
+					* @param that the addend
+					* @return this plus that, reduced if both were, by Henrici's method: with g = gcd(b, d),
+					* a/b + c/d = (t/h) / ((b/g)(d/h)) where t = a(d/g) + c(b/g) and h = gcd(t, g)
+					*/
+					Rational& operator += (const Rational& that) {
+						if(!reduced || !that.reduced) {
+							if(den == that.den)
+								*this = Rational(num + that.num, den, false);
+							else
+								*this = Rational(num * that.den + that.num * den, den * that.den, false);
+							return *this;}
+						const I one(1);
+						const I g = gcd(den, that.den);
+						if(g == one) {
+							*this = Rational(num * that.den + that.num * den, den * that.den, true);
+							return *this;}
+						const I s = den / g;
+						const I t = num * (that.den / g) + that.num * s;
+						if(t == I(0)) {
+							*this = Rational();
+							return *this;}
+						const I h = gcd(abs(t), g);
+						if(h == one)
+							*this = Rational(t, s * that.den, true);
+						else
+							*this = Rational(t / h, s * (that.den / h), true);
+						return *this;}
+
+					// -----------
+					// operator -=
+					// -----------
+
+					/**
+					* O(n^2) for the gcds when both are reduced, otherwise O(n^1.585)
+					* M(n)
+					* @param that the subtrahend
+					* @return this minus that, reduced if both were
+					*/
+					Rational& operator -= (const Rational& that) {
+						return *this += -that;}
+
+					// -----------
+					// operator *=
+					// -----------
+
+					/**
+					* O(n^2) for the gcds when both are reduced, otherwise O(n^1.585)
+					* M(n)
+					* @param that the multiplicand
+					* @return this times that, reduced if both were, by cross cancelling:
+					* a/b * c/d = ((a/g)(c/h)) / ((b/h)(d/g)) where g = gcd(a, d) and h = gcd(c, b)
+					*/
+					Rational& operator *= (const Rational& that) {
+						const I zero(0);
+						if(num == zero || that.num == zero) {
+							*this = Rational();
+							return *this;}
+						if(!reduced || !that.reduced) {
+							*this = Rational(num * that.num, den * that.den, false);
+							return *this;}
+						const I g = gcd(abs(num), that.den);
+						const I h = gcd(abs(that.num), den);
+						*this = Rational((num / g) * (that.num / h), (den / h) * (that.den / g), true);
+						return *this;}
+
+					// -----------
+					// operator /=
+					// -----------
+
+					/**
+					* O(n^2) for the gcds when both are reduced, otherwise O(n^1.585)
+					* M(n)
+					* @param that the divisor, not zero
+					* @return this divided by that, reduced if both were
+					* @throws invalid_argument if that is zero
+					*/
+					Rational& operator /= (const Rational& that) throw (std::invalid_argument) {
+						if(that.num == I(0))
+							throw std::invalid_argument("Rational::operator /=()");
+						return *this *= make(that.den, that.num, that.reduced);}
+			};
+
+			// ---
+			// abs
+			// ---
+
+			/**
+			* O(n)
+			* M(n)
+			* @param x the Rational
+			* @return |x|
+			*/
+			template <typename I>
+			Rational<I> abs (const Rational<I>& x) {
+				return x < Rational<I>() ? -x : x;}
+
+		} // integer
+	} // prog
+} // alg
+
+#endif // Rational_h
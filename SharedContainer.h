@@ -0,0 +1,303 @@
+// --------------------------
+// integer/SharedContainer.h
+// Tj Wrenn
+// --------------------------
+
+#ifndef SharedContainer_h
+#define SharedContainer_h
+
+// --------
+// includes
+// --------
+
+#include <atomic>      // atomic_thread_fence, memory_order_acquire
+#include <cstddef>     // size_t
+#include <memory>      // make_shared, shared_ptr
+#include <type_traits> // enable_if, is_integral
+#include <vector>      // vector
+
+// ----------
+// namespaces
+// ----------
+
+namespace alg   {
+	namespace prog    {
+		namespace integer {
+
+			// ---------------
+			// SharedContainer
+			// ---------------
+
+			/**
+			* a sequence container adaptor whose copies share one C until one of them is changed, at which point
+			* that copy takes a private C of its own.  An Integer<T, SharedContainer<T> > can therefore be copied,
+			* passed by value and returned in O(1) however many digits it has.
+			* The count of owners is atomic, so copies may be handed to and changed on other threads, but a
+			* single SharedContainer object needs the same locking as any other container.  Iterators and
+			* references obtained through the non-const members are only good until the container is next copied.
+			*/
+			template < typename T, typename C = std::vector<T> >
+			class SharedContainer {
+				public:
+					// --------
+					// typedefs
+					// --------
+
+					typedef C                                           container_type;
+
+					typedef typename container_type::value_type         value_type;
+					typedef typename container_type::size_type          size_type;
+					typedef typename container_type::difference_type    difference_type;
+
+					typedef typename container_type::reference          reference;
+					typedef typename container_type::const_reference    const_reference;
+
+					typedef typename container_type::iterator           iterator;
+					typedef typename container_type::const_iterator     const_iterator;
+
+					typedef typename container_type::reverse_iterator       reverse_iterator;
+					typedef typename container_type::const_reverse_iterator const_reverse_iterator;
+
+				private:
+					// ----
+					// data
+					// ----
+
+					std::shared_ptr<container_type> p;  //never null
+
+					// ---
+					// own
+					// ---
+
+					/**
+					* O(1) if this is the only owner, otherwise O(n) to take a private copy
+					* M(1) if this is the only owner, otherwise M(n)
+					* @return the container, which no other SharedContainer can see
+					*/
+					container_type& own () {
+						if(p.use_count() != 1)
+							p = std::make_shared<container_type>(*p);
+						else
+							//pairs with the release of the owners that let go, so their reads
+							//of the container happen before any write made through this one
+							std::atomic_thread_fence(std::memory_order_acquire);
+						return *p;}
+
+					// -------
+					// reserve
+					// -------
+
+					/**
+					* reserves room for n elements in containers that support it, and does nothing for the rest
+					*/
+					template <typename D>
+					static auto reserve (D& d, size_type n, int) -> decltype(d.reserve(n), void()) {
+						d.reserve(n);}
+
+					template <typename D>
+					static void reserve (D&, size_type, long) {}
+
+				public:
+					// ------------
+					// constructors
+					// ------------
+
+					/**
+					* O(1)
+					* M(1)
+					*/
+					SharedContainer () : p(std::make_shared<container_type>()) {}
+
+					/**
+					* O(n)
+					* M(n)
+					* @param n the number of elements
+					* @param v the value of each of them
+					*/
+					explicit SharedContainer (size_type n, const value_type& v = value_type()) :
+						p(std::make_shared<container_type>(n, v)) {}
+
+					/**
+					* O(n)
+					* M(n)
+					* @param first an iterator to the first element to copy
+					* @param last an iterator one past the last element to copy
+					*/
+					template <typename II>
+					SharedContainer (II first, II last, typename std::enable_if<!std::is_integral<II>::value>::type* = 0) :
+						p(std::make_shared<container_type>(first, last)) {}
+
+					// Default copy, destructor, and copy assignment, all O(1).
+					// SharedContainer (const SharedContainer&);
+					// ~SharedContainer ();
+					// SharedContainer& operator = (const SharedContainer&);
+
+					// -----------
+					// comparisons
+					// -----------
+
+					/**
+					* O(1) if lhs and rhs share a container, otherwise O(n)
+					* M(1)
+					*/
+					friend bool operator == (const SharedContainer& lhs, const SharedContainer& rhs) {
+						return lhs.p == rhs.p || *lhs.p == *rhs.p;}
+
+					friend bool operator != (const SharedContainer& lhs, const SharedContainer& rhs) {
+						return !(lhs == rhs);}
+
+					/**
+					* O(n)
+					* M(1)
+					*/
+					friend bool operator < (const SharedContainer& lhs, const SharedContainer& rhs) {
+						return lhs.p != rhs.p && *lhs.p < *rhs.p;}
+
+					// ---------
+					// iterators
+					// ---------
+
+					iterator begin () {
+						return own().begin();}
+
+					const_iterator begin () const {
+						return p->begin();}
+
+					iterator end () {
+						return own().end();}
+
+					const_iterator end () const {
+						return p->end();}
+
+					reverse_iterator rbegin () {
+						return own().rbegin();}
+
+					const_reverse_iterator rbegin () const {
+						return p->rbegin();}
+
+					reverse_iterator rend () {
+						return own().rend();}
+
+					const_reverse_iterator rend () const {
+						return p->rend();}
+
+					// --------
+					// capacity
+					// --------
+
+					size_type size () const {
+						return p->size();}
+
+					bool empty () const {
+						return p->empty();}
+
+					/**
+					* O(1) if this is the only owner and the container can reserve, otherwise O(n)
+					* M(n)
+					*/
+					void reserve (size_type n) {
+						reserve(own(), n, 0);}
+
+					/**
+					* O(1)
+					* M(1)
+					* @return true if no other SharedContainer shares this one's elements
+					*/
+					bool unique () const {
+						return p.use_count() == 1;}
+
+					// --------------
+					// element access
+					// --------------
+
+					reference operator [] (size_type index) {
+						return own()[index];}
+
+					const_reference operator [] (size_type index) const {
+						return (*p)[index];}
+
+					reference at (size_type index) {
+						return own().at(index);}
+
+					const_reference at (size_type index) const {
+						return p->at(index);}
+
+					reference front () {
+						return own().front();}
+
+					const_reference front () const {
+						return p->front();}
+
+					reference back () {
+						return own().back();}
+
+					const_reference back () const {
+						return p->back();}
+
+					// ---------
+					// modifiers
+					// ---------
+
+					void push_back (const value_type& v) {
+						own().push_back(v);}
+
+					void pop_back () {
+						own().pop_back();}
+
+					iterator insert (iterator pos, const value_type& v) {
+						return own().insert(pos, v);}
+
+					void insert (iterator pos, size_type n, const value_type& v) {
+						own().insert(pos, n, v);}
+
+					iterator erase (iterator pos) {
+						return own().erase(pos);}
+
+					iterator erase (iterator first, iterator last) {
+						return own().erase(first, last);}
+
+					void resize (size_type n, const value_type& v = value_type()) {
+						own().resize(n, v);}
+
+					/**
+					* O(n)
+					* M(n) a shared container is let go rather than copied
+					*/
+					void assign (size_type n, const value_type& v) {
+						if(unique()) own().assign(n, v);
+						else p = std::make_shared<container_type>(n, v);}
+
+					/**
+					* O(n)
+					* M(n) a shared container is let go rather than copied
+					*/
+					template <typename II>
+					typename std::enable_if<!std::is_integral<II>::value>::type assign (II first, II last) {
+						if(unique()) own().assign(first, last);
+						else p = std::make_shared<container_type>(first, last);}
+
+					/**
+					* O(n)
+					* M(1) a shared container is let go rather than copied
+					*/
+					void clear () {
+						if(unique()) own().clear();
+						else p = std::make_shared<container_type>();}
+
+					/**
+					* O(1)
+					* M(1)
+					*/
+					void swap (SharedContainer& that) {
+						p.swap(that.p);}
+			};
+
+			template <typename T, typename C>
+				void swap (SharedContainer<T, C>& x, SharedContainer<T, C>& y) {
+					x.swap(y);}
+
+		} // integer
+	} // prog
+} // alg
+
+#endif // SharedContainer_h
@@ -0,0 +1,118 @@
+// ------------------------------
+// integer/tests/async_cancel.cpp
+// Tj Wrenn
+// ------------------------------
+
+// cancels gcd_async while it is inside its first division, a 40000 digit number modulo a 1500 digit one,
+// and fails unless the future holds Cancelled well before that division could have finished.  It also
+// checks the uncancelled results, and leaves a task running on the default executor when main returns,
+// which is joined before Integer's statics are destroyed (make -C tests cancel runs it under ThreadSanitizer)
+
+// --------
+// includes
+// --------
+
+#include <atomic>    // atomic
+#include <chrono>    // duration, milliseconds, steady_clock
+#include <cstdlib>   // EXIT_FAILURE, EXIT_SUCCESS
+#include <functional> // function
+#include <future>    // future
+#include <iostream>  // cout
+#include <string>    // string
+#include <thread>    // sleep_for, yield
+
+#include "IntegerAsync.h"
+
+namespace {
+	typedef alg::prog::integer::Integer<int> integer;
+	typedef std::chrono::steady_clock        clock;
+
+	/**
+	* @return a number of n digits that is the same on every run
+	*/
+	std::string digits (std::size_t n, unsigned seed) {
+		std::string s(n, '0');
+		for(std::size_t i=0; i<n; ++i){
+			seed = seed*1103515245u + 12345u;
+			s[i] = static_cast<char>('0' + (seed >> 16) % 10);
+		}
+		s[0] = '7';
+		return s;}
+
+	double since (clock::time_point t) {
+		return std::chrono::duration<double>(clock::now() - t).count();}
+}
+
+int main () {
+	using namespace alg::prog::integer;
+	int bad = 0;
+
+	//the first division, timed on this thread
+	const integer x(digits(40000, 1));
+	const integer y(digits(1500, 2));
+	clock::time_point t = clock::now();
+	const integer first = x % y;
+	const double division = since(t);
+
+	//uncancelled, with progress that ends at 1
+	{
+		const integer a(digits(5000, 3));
+		const integer b(digits(300, 4));
+		AsyncOptions o;
+		std::atomic<double> last(0);
+		o.progress = [&last] (double f) {last = f;};
+		if(gcd_async(a, b, o).get() != gcd(a, b)) {
+			std::cout << "gcd_async: wrong gcd" << std::endl;
+			++bad;}
+		if(last != 1) {
+			std::cout << "gcd_async: progress ended at " << last << std::endl;
+			++bad;}
+	}
+
+	//cancelled a tenth of the way into the first division
+	{
+		AsyncOptions o;
+		std::atomic<bool> started(false);
+		o.executor = [&started] (std::function<void ()> task) {
+			joined_thread([&started, task] () {
+				started = true;
+				task();});};
+		std::future<integer> f = gcd_async(x, y, o);
+		while(!started) std::this_thread::yield();
+		std::this_thread::sleep_for(std::chrono::duration<double>(division / 10));
+		o.token.cancel();
+		t = clock::now();
+		f.wait();
+		const double latency = since(t);
+		try {
+			f.get();
+			std::cout << "gcd_async: finished despite being cancelled" << std::endl;
+			++bad;
+		}
+		catch(const Cancelled&) {}
+		std::cout << "gcd_async: cancelled after " << latency << "s, against " << division << "s for the first division" << std::endl;
+		if(latency > division / 4) {
+			std::cout << "gcd_async: cancellation waited for the division" << std::endl;
+			++bad;}
+	}
+
+	//a token cancelled before the start stops every computation before its first step
+	{
+		AsyncOptions o;
+		o.token.cancel();
+		int held = 0;
+		try {gcd_async(x, y, o).get();}        catch(const Cancelled&) {++held;}
+		try {divide_async(x, y, o).get();}     catch(const Cancelled&) {++held;}
+		try {pow_async(y, 1000, o).get();}     catch(const Cancelled&) {++held;}
+		try {fact_async(integer(5000), o).get();} catch(const Cancelled&) {++held;}
+		if(held != 4) {
+			std::cout << "cancelled before the start: " << held << " of 4 held Cancelled" << std::endl;
+			++bad;}
+	}
+
+	//left running, for the default executor to join when the program exits
+	pow_async(y, 64);
+	std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+	std::cout << bad << " failures" << std::endl;
+	return bad ? EXIT_FAILURE : EXIT_SUCCESS;}
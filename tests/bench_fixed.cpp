@@ -0,0 +1,94 @@
+// -----------------------------
+// integer/tests/bench_fixed.cpp
+// Tj Wrenn
+// -----------------------------
+
+// times +, -, *, / and % on FixedInteger<128>, <256>, <512> and <1024> against Integer<int> holding the
+// same values, and checks that both give the same results.  + and - take operands of Bits - 2 bits, *
+// takes two of Bits/2 - 1 bits so that the product fits, and / and % divide Bits - 1 bits by Bits/2.
+// Each time is the best of five runs of at least 20 ms, in nanoseconds per operation, and the ratio is
+// Integer's time over FixedInteger's.  It is opt in, so make -C tests bench-fixed runs it but make check
+// does not.
+
+// --------
+// includes
+// --------
+
+#include <cstddef>   // size_t
+#include <cstdlib>   // EXIT_FAILURE, EXIT_SUCCESS
+#include <iomanip>   // setprecision
+#include <iostream>  // cout, fixed
+#include <random>    // mt19937_64
+#include <sstream>   // ostringstream
+#include <string>    // string
+
+#include "FixedInteger.h"
+#include "Integer.h"
+#include "timing.h"
+
+namespace {
+	using namespace alg::prog::integer;
+	typedef Integer<int> integer;
+
+	int bad = 0;
+
+	template <typename I>
+	std::string str (const I& x) {
+		std::ostringstream out;
+		out << x;
+		return out.str();}
+
+	/**
+	* @return a random number of exactly k bits, in decimal
+	*/
+	std::string bits (std::mt19937_64& g, std::size_t k) {
+		integer x(1);
+		for(std::size_t i=1; i<k; ++i)
+			x = x + x + integer(static_cast<int>(g() & 1));
+		return str(x);}
+
+	/**
+	* times a op b on FixedInteger<Bits> and on Integer, and prints a line of the table
+	*/
+	template <std::size_t Bits, typename F>
+	void row (const char* op, const std::string& a, const std::string& b, F f) {
+		FixedInteger<Bits> x(a), y(b);
+		integer u(a), v(b);
+		if(str(f(x, y)) != str(f(u, v))) {
+			++bad;
+			std::cout << "FAIL " << a << " " << op << " " << b << std::endl;}
+		const double fixed = best([&] () {
+			opaque(x);
+			opaque(y);
+			keep(f(x, y));});
+		const double general = best([&] () {
+			opaque(u);
+			opaque(v);
+			keep(f(u, v));});
+		std::cout.width(2);  std::cout << std::left << op;
+		std::cout.width(6);  std::cout << std::right << Bits;
+		std::cout << std::fixed << std::setprecision(1);
+		std::cout.width(14); std::cout << fixed * 1e9;
+		std::cout.width(14); std::cout << general * 1e9;
+		std::cout.width(10); std::cout << general / fixed << std::endl;}
+
+	template <std::size_t Bits>
+	void rows (std::mt19937_64& g) {
+		const std::string wide = bits(g, Bits - 2), other = bits(g, Bits - 2);
+		const std::string half = bits(g, Bits/2 - 1), halves = bits(g, Bits/2 - 1);
+		const std::string dividend = bits(g, Bits - 1), divisor = bits(g, Bits/2);
+		row<Bits>("+", wide, other, [] (const auto& x, const auto& y) {return x + y;});
+		row<Bits>("-", wide, other, [] (const auto& x, const auto& y) {return x - y;});
+		row<Bits>("*", half, halves, [] (const auto& x, const auto& y) {return x * y;});
+		row<Bits>("/", dividend, divisor, [] (const auto& x, const auto& y) {return x / y;});
+		row<Bits>("%", dividend, divisor, [] (const auto& x, const auto& y) {return x % y;});}
+}
+
+int main () {
+	std::mt19937_64 g(1);
+	std::cout << "op  bits    Fixed (ns)  Integer (ns)     ratio" << std::endl;
+	rows<128>(g);
+	rows<256>(g);
+	rows<512>(g);
+	rows<1024>(g);
+	return bad ? EXIT_FAILURE : EXIT_SUCCESS;}
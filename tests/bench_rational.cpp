@@ -0,0 +1,83 @@
+// --------------------------------
+// integer/tests/bench_rational.cpp
+// Tj Wrenn
+// --------------------------------
+
+// times the harmonic sum 1/1 + 1/2 + ... + 1/n in Rational<Integer<int> >, once with reduced terms,
+// added by Henrici's methods so that every partial sum is in lowest terms, and once with terms made by
+// unreduced(), cross multiplied and normalized only at the end, and checks that both give the same sum.
+// n runs through 1, 2 and 5 times the powers of ten from 1000 up to terms, and then terms itself.  The
+// deferred gcd works on the whole unreduced numerator and denominator, so its cost grows much faster than
+// n, and the unreduced sums stop once one takes more than UNREDUCED_LIMIT seconds.  It is opt in, so
+//
+//     make -C tests bench-rational [TERMS=100000]
+//
+// runs it but make check does not.
+
+// --------
+// includes
+// --------
+
+#include <chrono>    // duration, steady_clock
+#include <cstdlib>   // atol, EXIT_FAILURE, EXIT_SUCCESS
+#include <iostream>  // cerr, cout
+#include <vector>    // vector
+
+#include "Rational.h"
+
+namespace {
+	using namespace alg::prog::integer;
+	typedef Integer<int>      integer;
+	typedef Rational<integer> rational;
+	typedef std::chrono::steady_clock clock;
+
+	const double UNREDUCED_LIMIT = 10;
+
+	double since (clock::time_point t) {
+		return std::chrono::duration<double>(clock::now() - t).count();}
+}
+
+int main (int argc, char** argv) {
+	const long terms = argc > 1 ? std::atol(argv[1]) : 100000;
+	if(argc > 2 || terms < 1) {
+		std::cerr << "usage: " << argv[0] << " [terms]" << std::endl;
+		return EXIT_FAILURE;}
+
+	std::vector<long> sizes;
+	for(long p = 1000; p < terms; p *= 10) {
+		const long STEPS[] = {1, 2, 5};
+		for(int i=0; i<3; ++i) {
+			if(STEPS[i]*p < terms) sizes.push_back(STEPS[i]*p);}}
+	sizes.push_back(terms);
+
+	std::cout << "   terms  digits   reduced (s)  unreduced (s)" << std::endl;
+	bool unreduced = true;
+	int bad = 0;
+	for(std::size_t i=0; i<sizes.size(); ++i) {
+		const long n = sizes[i];
+		clock::time_point t = clock::now();
+		rational h;
+		for(long k=1; k<=n; ++k)
+			h += rational(integer::ONE, integer(static_cast<int>(k)));
+		const double reduced = since(t);
+
+		std::cout.width(8);  std::cout << n;
+		std::cout.width(8);  std::cout << h.denominator().size();
+		std::cout.width(14); std::cout << reduced;
+		if(unreduced) {
+			t = clock::now();
+			rational u;
+			for(long k=1; k<=n; ++k)
+				u += rational::unreduced(integer::ONE, integer(static_cast<int>(k)));
+			u.normalize();
+			const double deferred = since(t);
+			std::cout.width(15); std::cout << deferred;
+			if(u.numerator() != h.numerator() || u.denominator() != h.denominator()) {
+				std::cout << "  FAIL the sums differ";
+				++bad;}
+			unreduced = deferred <= UNREDUCED_LIMIT;
+		}
+		else
+			std::cout.width(15), std::cout << "-";
+		std::cout << std::endl;}
+	return bad ? EXIT_FAILURE : EXIT_SUCCESS;}
@@ -0,0 +1,697 @@
+// ------------------------------
+// integer/tests/differential.cpp
+// Tj Wrenn
+// ------------------------------
+
+// checks Integer's operators against Ref, a deliberately simple bignum below, and against GMP when
+// built with INTEGER_TEST_GMP, along with iroot, isqrt, is_square and is_perfect_power on random numbers
+// and on powers of small primes and either side of them, and to_string and from_string in every base
+// from 2 to 36, then times *, / and gcd per size bucket against a saved baseline.
+//
+// differential [--seed n] [--cases n] [--no-timing] [--save file] [--baseline file] [--slowdown x]
+//
+// exits nonzero if any result differs, or if any bucket is more than x (default 1.5) times slower
+// than the same bucket in the baseline file.  make -C tests fuzz runs it, make -C tests asan runs
+// the differential part under AddressSanitizer, and make -C tests hash runs it built with
+// INTEGER_CACHE_HASH, where the hash checks below catch a cached hash that an operator failed to drop.
+
+// --------
+// includes
+// --------
+
+#include <algorithm> // max, min
+#include <cctype>    // toupper
+#include <cstdint>   // uint32_t, uint64_t
+#include <cstdlib>   // atof, atoi, EXIT_FAILURE, EXIT_SUCCESS
+#include <deque>     // deque
+#include <fstream>   // ifstream, ofstream
+#include <iostream>  // cerr, cout
+#include <map>       // map
+#include <random>    // mt19937_64
+#include <sstream>   // ostringstream
+#include <stdexcept> // invalid_argument
+#include <string>    // string
+#include <utility>   // pair
+#include <vector>    // vector
+
+#ifdef INTEGER_TEST_GMP
+#include <gmpxx.h>   // mpz_class
+#endif
+
+#include "Integer.h"
+#include "SharedContainer.h"
+#include "timing.h"
+
+namespace {
+	// ---
+	// Ref
+	// ---
+
+	/**
+	* sign and magnitude in base 10^9 limbs, least significant first, with no leading zero limbs, so
+	* that zero has none.  Every algorithm is the plainest one that works: schoolbook multiplication,
+	* long division that finds each quotient limb by binary search, and Euclid's gcd.
+	*/
+	struct Ref {
+		typedef std::vector<std::uint32_t> limbs;
+		static const std::uint32_t BASE = 1000000000u;
+
+		bool  neg;
+		limbs m;
+
+		static void trim (limbs& a) {
+			while(!a.empty() && !a.back()) a.pop_back();}
+
+		static Ref make (bool neg, const limbs& m) {
+			Ref r = {neg && !m.empty(), m};
+			return r;}
+
+		static Ref parse (const std::string& s) {
+			const std::size_t first = '-' == s[0];
+			Ref r = {first == 1, limbs()};
+			for(std::size_t end = s.size(); end > first; ){
+				const std::size_t begin = end - std::min<std::size_t>(9, end - first);
+				r.m.push_back(static_cast<std::uint32_t>(std::atoi(s.substr(begin, end - begin).c_str())));
+				end = begin;
+			}
+			trim(r.m);
+			r.neg = r.neg && !r.m.empty();
+			return r;}
+
+		std::string str () const {
+			if(m.empty()) return "0";
+			std::ostringstream out;
+			if(neg) out << "-";
+			out << m.back();
+			for(std::size_t i = m.size() - 1; i--; ){
+				const std::string d = std::to_string(m[i]);
+				out << std::string(9 - d.size(), '0') << d;
+			}
+			return out.str();}
+
+		static int compare (const limbs& a, const limbs& b) {
+			if(a.size() != b.size()) return a.size() < b.size() ? -1 : 1;
+			for(std::size_t i = a.size(); i--; ){
+				if(a[i] != b[i]) return a[i] < b[i] ? -1 : 1;
+			}
+			return 0;}
+
+		static limbs add (const limbs& a, const limbs& b) {
+			limbs r(std::max(a.size(), b.size()) + 1, 0);
+			std::uint32_t carry = 0;
+			for(std::size_t i=0; i<r.size(); ++i){
+				std::uint32_t s = carry + (i < a.size() ? a[i] : 0) + (i < b.size() ? b[i] : 0);
+				carry = s >= BASE;
+				r[i] = carry ? s - BASE : s;
+			}
+			trim(r);
+			return r;}
+
+		// a >= b
+		static limbs subtract (const limbs& a, const limbs& b) {
+			limbs r(a);
+			std::int64_t borrow = 0;
+			for(std::size_t i=0; i<r.size(); ++i){
+				std::int64_t d = std::int64_t(r[i]) - (i < b.size() ? b[i] : 0) - borrow;
+				borrow = d < 0;
+				r[i] = static_cast<std::uint32_t>(borrow ? d + BASE : d);
+			}
+			trim(r);
+			return r;}
+
+		static limbs multiply (const limbs& a, const limbs& b) {
+			if(a.empty() || b.empty()) return limbs();
+			limbs r(a.size() + b.size(), 0);
+			for(std::size_t j=0; j<b.size(); ++j){
+				std::uint64_t carry = 0;
+				for(std::size_t i=0; i<a.size(); ++i){
+					const std::uint64_t t = std::uint64_t(a[i])*b[j] + r[i+j] + carry;
+					r[i+j] = static_cast<std::uint32_t>(t % BASE);
+					carry = t / BASE;
+				}
+				r[j + a.size()] = static_cast<std::uint32_t>(carry);
+			}
+			trim(r);
+			return r;}
+
+		// b is not zero
+		static void divide (const limbs& a, const limbs& b, limbs& q, limbs& r) {
+			q.assign(a.size(), 0);
+			r.clear();
+			for(std::size_t i = a.size(); i--; ){
+				r.insert(r.begin(), a[i]);
+				trim(r);
+				std::uint32_t lo = 0;
+				std::uint32_t hi = BASE - 1;
+				while(lo < hi){
+					const std::uint32_t t = lo + (hi - lo + 1)/2;
+					if(compare(multiply(b, limbs(1, t)), r) <= 0) lo = t;
+					else hi = t - 1;
+				}
+				if(lo) r = subtract(r, multiply(b, limbs(1, lo)));
+				q[i] = lo;
+			}
+			trim(q);}
+
+		friend Ref operator - (const Ref& x) {
+			return make(!x.neg, x.m);}
+
+		friend Ref operator + (const Ref& x, const Ref& y) {
+			if(x.neg == y.neg) return make(x.neg, add(x.m, y.m));
+			if(compare(x.m, y.m) >= 0) return make(x.neg, subtract(x.m, y.m));
+			return make(y.neg, subtract(y.m, x.m));}
+
+		friend Ref operator - (const Ref& x, const Ref& y) {
+			return x + -y;}
+
+		friend Ref operator * (const Ref& x, const Ref& y) {
+			return make(x.neg != y.neg, multiply(x.m, y.m));}
+
+		// truncates toward zero
+		friend Ref operator / (const Ref& x, const Ref& y) {
+			limbs q, r;
+			divide(x.m, y.m, q, r);
+			return make(x.neg != y.neg, q);}
+
+		// x >= 0 and y > 0
+		friend Ref operator % (const Ref& x, const Ref& y) {
+			limbs q, r;
+			divide(x.m, y.m, q, r);
+			return make(false, r);}
+
+		static Ref gcd (Ref x, Ref y) {
+			x.neg = y.neg = false;
+			while(!y.m.empty()){
+				Ref t = x % y;
+				x = y;
+				y = t;
+			}
+			return x;}
+
+		static Ref pow (const Ref& x, int e) {
+			Ref r = {false, limbs(1, 1)};
+			for(int i=0; i<e; ++i) r = r * x;
+			return r;}
+	};
+
+	// ---------
+	// operands
+	// ---------
+
+	/**
+	* lengths either side of the limits inside Integer: a word, SHORT_DIVISOR, KARATSUBA_THRESHOLD
+	* and twice it, and a few long ones
+	*/
+	const std::size_t LENGTHS[] = {1, 2, 3, 9, 10, 16, 17, 18, 19, 30, 47, 48, 49, 50, 95, 96, 97, 150, 300, 600, 1200};
+
+	std::string random_digits (std::mt19937_64& g, std::size_t n) {
+		std::string s(n, '0');
+		for(std::size_t i=0; i<n; ++i) s[i] = static_cast<char>('0' + g() % 10);
+		s[0] = static_cast<char>('1' + g() % 9);
+		return s;}
+
+	/**
+	* @return a random or adversarial magnitude: 10^k - 1, 10^k, 10^k + 1, a run of nines followed by a run of
+	* zeros, a number with long runs of zeros inside, or plain random digits
+	*/
+	std::string operand (std::mt19937_64& g) {
+		const std::size_t n = LENGTHS[g() % (sizeof(LENGTHS) / sizeof(LENGTHS[0]))];
+		switch(g() % 10){
+			case 0:  return std::string(n, '9');
+			case 1:  return "1" + std::string(n - 1, '0');
+			case 2:  return n == 1 ? "2" : "1" + std::string(n - 2, '0') + "1";
+			case 3:  return std::string(n, '9') + std::string(g() % 40, '0');
+			case 4: {
+				std::string s = random_digits(g, n);
+				for(std::size_t i = 1; i < n; i += 1 + g() % 8){
+					const std::size_t run = std::min<std::size_t>(n - i, g() % 30);
+					s.replace(i, run, run, '0');
+					i += run;
+				}
+				return s;}
+			case 5:  return g() % 2 ? "0" : "1";
+			default: return random_digits(g, n);
+		}}
+
+	std::string sign (std::mt19937_64& g, const std::string& s) {
+		return s != "0" && g() % 3 == 0 ? "-" + s : s;}
+
+	// ------
+	// checks
+	// ------
+
+	const std::string THROWS = "throws";
+
+	struct Checker {
+		long cases;
+		long mismatches;
+
+		void operator () (const std::string& what, const std::string& a, const std::string& b,
+		                  const std::string& got, const std::string& expected) {
+			++cases;
+			if(got == expected) return;
+			if(++mismatches <= 10){
+				std::cerr << "MISMATCH " << what << "\n  a = " << a << "\n  b = " << b
+				          << "\n  got      " << got << "\n  expected " << expected << std::endl;
+			}}
+	};
+
+	template <typename I>
+	std::string str (const I& x) {
+		std::ostringstream out;
+		out << x;
+		return out.str();}
+
+	/**
+	* what Ref and, when built with it, GMP give for one pair of operands
+	*/
+	struct Expected {
+		std::string sum, difference, product, quotient, remainder, gcd, square, twice, self_quotient, self_remainder, power;
+		bool less, equal;
+		int exponent;
+	};
+
+	Expected expect (const std::string& a, const std::string& b, int exponent) {
+		const Ref x = Ref::parse(a);
+		const Ref y = Ref::parse(b);
+		Expected e;
+		e.sum            = (x + y).str();
+		e.difference     = (x - y).str();
+		e.product        = (x * y).str();
+		e.quotient       = y.m.empty() ? THROWS : (x / y).str();
+		e.remainder      = x.neg || y.neg || y.m.empty() ? THROWS : (x % y).str();
+		e.gcd            = x.neg || y.neg || (x.m.empty() && y.m.empty()) ? THROWS : Ref::gcd(x, y).str();
+		e.square         = (x * x).str();
+		e.twice          = (x + x).str();
+		e.self_quotient  = x.m.empty() ? THROWS : "1";
+		e.self_remainder = x.neg || x.m.empty() ? THROWS : "0";
+		e.exponent       = exponent;
+		e.power          = Ref::pow(x, exponent).str();
+		const Ref d = x - y;
+		e.less  = d.neg;
+		e.equal = d.m.empty();
+		return e;}
+
+#ifdef INTEGER_TEST_GMP
+	/**
+	* checks Ref itself, so that a bug in Ref cannot hide one in Integer
+	*/
+	void against_gmp (Checker& check, const std::string& a, const std::string& b, const Expected& e) {
+		const mpz_class x(a);
+		const mpz_class y(b);
+		check("gmp +", a, b, mpz_class(x + y).get_str(), e.sum);
+		check("gmp -", a, b, mpz_class(x - y).get_str(), e.difference);
+		check("gmp *", a, b, mpz_class(x * y).get_str(), e.product);
+		if(y != 0) check("gmp /", a, b, mpz_class(x / y).get_str(), e.quotient);
+		if(x >= 0 && y > 0) check("gmp %", a, b, mpz_class(x % y).get_str(), e.remainder);
+		if(x >= 0 && y >= 0 && (x != 0 || y != 0)) check("gmp gcd", a, b, mpz_class(gcd(x, y)).get_str(), e.gcd);
+		mpz_class p;
+		mpz_pow_ui(p.get_mpz_t(), x.get_mpz_t(), e.exponent);
+		check("gmp pow", a, b, p.get_str(), e.power);}
+#endif
+
+	/**
+	* @return "ok" if x hashes as a freshly parsed copy of its value does, which catches a hash cached
+	* before x was last changed when built with INTEGER_CACHE_HASH
+	*/
+	template <typename I>
+	std::string hashes (const I& x) {
+		return x.hash() == I(str(x)).hash() ? "ok" : "stale hash";}
+
+	template <typename I, typename F>
+	std::string attempt (F f) {
+		try {
+			return str(f());}
+		catch(std::invalid_argument&) {
+			return THROWS;}}
+
+	/**
+	* checks every operator of I on a and b, including each compound assignment applied to a copy of
+	* itself, which for SharedContainer storage shares its digits with the operand
+	*/
+	template <typename I>
+	void differ (Checker& check, const char* name, const std::string& a, const std::string& b, const Expected& e) {
+		const std::string n(name);
+		const I x(a);
+		const I y(b);
+		check(n + " +",  a, b, str(x + y), e.sum);
+		check(n + " -",  a, b, str(x - y), e.difference);
+		check(n + " *",  a, b, str(x * y), e.product);
+		check(n + " /",  a, b, attempt<I>([&] () {return x / y;}), e.quotient);
+		check(n + " %",  a, b, attempt<I>([&] () {return x % y;}), e.remainder);
+		check(n + " gcd", a, b, attempt<I>([&] () {return gcd(x, y);}), e.gcd);
+		check(n + " pow", a, b, str(pow(x, e.exponent)), e.power);
+		check(n + " <",  a, b, std::to_string(x < y), std::to_string(e.less));
+		check(n + " ==", a, b, std::to_string(x == y), std::to_string(e.equal));
+		check(n + " neg", a, b, str(-x), (-Ref::parse(a)).str());
+		check(n + " abs", a, b, str(abs(x)), Ref::make(false, Ref::parse(a).m).str());
+
+		check(n + " x += y", a, b, str(I(x) += y), e.sum);
+		check(n + " x -= y", a, b, str(I(x) -= y), e.difference);
+		check(n + " x *= y", a, b, str(I(x) *= y), e.product);
+
+		I t = x;
+		check(n + " x *= x", a, a, str(t *= t), e.square);
+		t = x;
+		check(n + " x += x", a, a, str(t += t), e.twice);
+		t = x;
+		check(n + " x -= x", a, a, str(t -= t), "0");
+		t = x;
+		check(n + " x /= x", a, a, attempt<I>([&] () {return t /= t;}), e.self_quotient);
+		t = x;
+		check(n + " x %= x", a, a, attempt<I>([&] () {return t %= t;}), e.self_remainder);
+
+		//each change to an Integer that has been hashed must drop the hash it cached
+		t = x;
+		t.hash();
+		t += y;
+		check(n + " hash x += y", a, b, hashes(t), "ok");
+		t.hash();
+		t *= t;
+		check(n + " hash x *= x", a, b, hashes(t), "ok");
+		t.hash();
+		t -= y;
+		check(n + " hash x -= y", a, b, hashes(t), "ok");
+		if(e.quotient != THROWS) {
+			t = x;
+			t.hash();
+			t /= y;
+			check(n + " hash x /= y", a, b, hashes(t), "ok");}}
+
+	// -----
+	// roots
+	// -----
+
+	/**
+	* @return true if r is x's k-th root truncated toward zero: r has x's sign and |r|^k <= |x| < (|r|+1)^k,
+	* as Ref alone works out
+	*/
+	bool is_root (const Ref& x, int k, const Ref& r) {
+		if(r.neg != x.neg) return false;
+		const Ref a = Ref::make(false, x.m);
+		const Ref b = Ref::make(false, r.m);
+		return Ref::compare(Ref::pow(b, k).m, a.m) <= 0 && Ref::compare(a.m, Ref::pow(b + Ref::parse("1"), k).m) < 0;}
+
+	/**
+	* @return a random or adversarial operand, or an e-th power of a product of small primes or of a
+	* random number, or one either side of such a power, with either sign, along with e
+	*/
+	std::pair<std::string, int> power_operand (std::mt19937_64& g) {
+		if(g() % 4 == 0) return std::make_pair(sign(g, operand(g)), 2 + static_cast<int>(g() % 10));
+		static const char* PRIMES[] = {"2", "3", "5", "7", "11", "13"};
+		Ref b = Ref::parse("1");
+		if(g() % 3 == 0)
+			b = Ref::parse(random_digits(g, 1 + g() % 20));
+		else {
+			for(int i = 1 + static_cast<int>(g() % 5); i; --i)
+				b = b * Ref::parse(PRIMES[g() % 6]);
+		}
+		const int e = 2 + static_cast<int>(g() % 30);
+		Ref x = Ref::pow(b, e);
+		switch(g() % 4){
+			case 0: x = x + Ref::parse("1"); break;
+			case 1: x = x - Ref::parse("1"); break;
+		}
+		return std::make_pair(sign(g, x.str()), e);}
+
+	/**
+	* checks iroot(a, k), isqrt(a), is_square(a) and, for a of no more than 300 digits, is_perfect_power(a)
+	* on I against what Ref makes of the results, and against GMP when built with it
+	*/
+	template <typename I>
+	void differ_roots (Checker& check, const char* name, const std::string& a, int k) {
+		const std::string n(name);
+		const std::string ks = std::to_string(k);
+		const I x(a);
+		const Ref r = Ref::parse(a);
+
+		const std::string root = attempt<I>([&] () {return iroot(x, k);});
+		if(k < 1 || (r.neg && !(k & 1)))
+			check(n + " iroot", a, ks, root, THROWS);
+		else
+			check(n + " iroot", a, ks, is_root(r, k, Ref::parse(root)) ? "root" : root, "root");
+
+		const std::string square = attempt<I>([&] () {return isqrt(x);});
+		if(r.neg)
+			check(n + " isqrt", a, "2", square, THROWS);
+		else
+			check(n + " isqrt", a, "2", is_root(r, 2, Ref::parse(square)) ? "root" : square, "root");
+		const bool is_sq = !r.neg && Ref::compare((Ref::parse(square) * Ref::parse(square)).m, r.m) == 0;
+		check(n + " is_square", a, "", std::to_string(is_square(x)), std::to_string(is_sq));
+
+		if(r.m.size() > 34) return;
+		//|x| is a perfect power if it is a p-th power for some prime p below log2|x|, which must be odd if x < 0
+		bool power = r.m.empty() || Ref::compare(r.m, Ref::limbs(1, 1)) == 0;
+		const std::size_t bits = 30*r.m.size();
+		const I m = abs(x);
+		for(std::size_t p = r.neg ? 3 : 2; !power && p <= bits; ++p){
+			bool prime = true;
+			for(std::size_t d=2; d*d<=p && prime; ++d)
+				prime = p % d != 0;
+			if(!prime) continue;
+			const Ref t = Ref::parse(str(iroot(m, static_cast<int>(p))));
+			power = Ref::compare(Ref::pow(t, static_cast<int>(p)).m, r.m) == 0;
+		}
+		check(n + " is_perfect_power", a, "", std::to_string(is_perfect_power(x)), std::to_string(power));
+
+#ifdef INTEGER_TEST_GMP
+		const mpz_class z(a);
+		if(k >= 1 && (z >= 0 || (k & 1))){
+			mpz_class t;
+			mpz_root(t.get_mpz_t(), z.get_mpz_t(), k);
+			check("gmp iroot", a, ks, root, t.get_str());
+		}
+		if(z >= 0) check("gmp isqrt", a, "2", square, mpz_class(sqrt(z)).get_str());
+		check("gmp is_square", a, "", std::to_string(is_square(x)), std::to_string(mpz_perfect_square_p(z.get_mpz_t()) != 0));
+		check("gmp is_perfect_power", a, "", std::to_string(is_perfect_power(x)), std::to_string(mpz_perfect_power_p(z.get_mpz_t()) != 0));
+#endif
+		}
+
+	// -----
+	// radix
+	// -----
+
+	const char SYMBOLS[] = "0123456789abcdefghijklmnopqrstuvwxyz{";
+
+	/**
+	* checks that from_string(a.to_string(base), base) gives a back, in lower and in upper case, and when
+	* built with GMP that to_string gives mpz_get_str's digits and that mpz_set_str reads them as a
+	*/
+	template <typename I>
+	void differ_radix (Checker& check, const char* name, const std::string& a, int base) {
+		const std::string n(name);
+		const std::string bs = std::to_string(base);
+		const std::string s = I(a).to_string(base);
+		std::string upper(s);
+		for(std::size_t i=0; i<upper.size(); ++i)
+			upper[i] = static_cast<char>(std::toupper(upper[i]));
+		check(n + " from_string(to_string)", a, bs, attempt<I>([&] () {return I::from_string(s, base);}), a);
+		check(n + " from_string in upper case", a, bs, attempt<I>([&] () {return I::from_string(upper, base);}), a);
+#ifdef INTEGER_TEST_GMP
+		mpz_class z;
+		check("gmp to_string", a, bs, s, mpz_class(a).get_str(base));
+		check("gmp mpz_set_str(to_string)", a, bs, z.set_str(s, base) ? THROWS : z.get_str(), a);
+#endif
+		}
+
+	/**
+	* checks that from_string rejects s in base, and that to_string also rejects base if it is outside 2 to 36
+	*/
+	template <typename I>
+	void reject_radix (Checker& check, const char* name, const std::string& s, int base) {
+		const std::string n(name);
+		const std::string bs = std::to_string(base);
+		check(n + " from_string rejects", s, bs, attempt<I>([&] () {return I::from_string(s, base);}), THROWS);
+		if(base < 2 || base > 36)
+			check(n + " to_string rejects", "1", bs, attempt<I>([&] () {return I::ONE.to_string(base);}), THROWS);}
+
+	// ------
+	// timing
+	// ------
+
+	typedef std::map<std::pair<std::string, std::size_t>, double> Timings;
+
+	/**
+	* times n by n digit *, 2n by n digit / and n by n digit gcd for Integer, Ref and GMP
+	*/
+	Timings time_buckets (std::mt19937_64& g, std::ostream& out) {
+		typedef alg::prog::integer::Integer<int> I;
+		const std::size_t SIZES[] = {16, 64, 256, 1024, 4096};
+		const char*       OPS[]   = {"*", "/", "gcd"};
+		Timings integer;
+		out << "op    digits      Integer          Ref"
+#ifdef INTEGER_TEST_GMP
+		    << "          GMP"
+#endif
+		    << std::endl;
+		for(int op=0; op<3; ++op){
+			for(std::size_t s=0; s<sizeof(SIZES)/sizeof(SIZES[0]); ++s){
+				const std::size_t n = SIZES[s];
+				if(op == 2 && n > 1024) continue;
+				const std::string a = random_digits(g, op == 1 ? 2*n : n);
+				const std::string b = random_digits(g, n);
+				const I x(a), y(b);
+				const Ref p = Ref::parse(a), q = Ref::parse(b);
+				double ti, tr;
+				if(op == 0)      { ti = best([&] () {return x * y;});      tr = best([&] () {return p * q;});}
+				else if(op == 1) { ti = best([&] () {return x / y;});      tr = best([&] () {return p / q;});}
+				else             { ti = best([&] () {return gcd(x, y);}); tr = best([&] () {return Ref::gcd(p, q);});}
+				integer[std::make_pair(std::string(OPS[op]), n)] = ti;
+				out.width(3);  out << std::left << OPS[op];
+				out.width(10); out << std::right << n;
+				out.width(13); out << ti;
+				out.width(13); out << tr;
+#ifdef INTEGER_TEST_GMP
+				const mpz_class u(a), v(b);
+				double tg;
+				if(op == 0)      tg = best([&] () {return mpz_class(u * v);});
+				else if(op == 1) tg = best([&] () {return mpz_class(u / v);});
+				else             tg = best([&] () {return mpz_class(gcd(u, v));});
+				out.width(13); out << tg;
+#endif
+				out << std::endl;
+			}
+		}
+		return integer;}
+
+	Timings load (const std::string& path) {
+		Timings r;
+		std::ifstream in(path.c_str());
+		std::string op;
+		std::size_t n;
+		double t;
+		while(in >> op >> n >> t) r[std::make_pair(op, n)] = t;
+		return r;}
+}
+
+int main (int argc, char** argv) {
+	using namespace alg::prog::integer;
+
+	unsigned long seed     = 1;
+	long          cases    = 2000;
+	bool          timing   = true;
+	double        slowdown = 1.5;
+	std::string   save;
+	std::string   baseline;
+	for(int i=1; i<argc; ++i){
+		const std::string arg = argv[i];
+		const bool more = i + 1 < argc;
+		if(arg == "--seed" && more)          seed     = std::strtoul(argv[++i], 0, 10);
+		else if(arg == "--cases" && more)    cases    = std::atol(argv[++i]);
+		else if(arg == "--no-timing")        timing   = false;
+		else if(arg == "--slowdown" && more) slowdown = std::atof(argv[++i]);
+		else if(arg == "--save" && more)     save     = argv[++i];
+		else if(arg == "--baseline" && more) baseline = argv[++i];
+		else {
+			std::cerr << "usage: " << argv[0] << " [--seed n] [--cases n] [--no-timing] [--save file] [--baseline file] [--slowdown x]" << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+
+	std::mt19937_64 g(seed);
+	Checker check = {0, 0};
+	for(long c=0; c<cases; ++c){
+		const std::string a = sign(g, operand(g));
+		std::string b;
+		//besides an unrelated b, try b close to a, equal to it, and dividing it exactly
+		switch(g() % 6){
+			case 0:  b = (Ref::parse(a) + Ref::parse(g() % 2 ? "1" : "-1")).str(); break;
+			case 1:  b = a; break;
+			case 2: {
+				const std::string d = sign(g, operand(g));
+				b = d;
+				if(d != "0") {
+					const std::string x = (Ref::parse(a) * Ref::parse(d)).str();
+					const Expected e = expect(x, d, 0);
+					differ< Integer<int> >(check, "vector", x, d, e);}
+				break;}
+			default: b = sign(g, operand(g));
+		}
+		const int exponent = Ref::parse(a).m.size() <= 4 ? static_cast<int>(g() % 25) : static_cast<int>(g() % 3);
+		const Expected e = expect(a, b, exponent);
+#ifdef INTEGER_TEST_GMP
+		against_gmp(check, a, b, e);
+#endif
+		differ< Integer<int> >(check, "vector", a, b, e);
+		differ< Integer<int, std::deque<int> > >(check, "deque", a, b, e);
+		differ< Integer<int, SharedContainer<int> > >(check, "SharedContainer", a, b, e);
+	}
+
+	//roots: the edges at every k from -1 to 6, then random operands and powers at their own exponent, a
+	//divisor or multiple of it, or a k from 1 to 40
+	const char* EDGES[] = {"0", "1", "-1", "2", "-2", "4", "-8", "-27", "1024", "18446744073709551615",
+	                       "18446744073709551616", "18446744073709551617", "10000000000000000000000000000000000000000"};
+	for(std::size_t i=0; i<sizeof(EDGES)/sizeof(EDGES[0]); ++i){
+		for(int k=-1; k<=6; ++k)
+			differ_roots< Integer<int> >(check, "vector", EDGES[i], k);
+	}
+	for(long c=0; c<cases/10; ++c){
+		const std::pair<std::string, int> x = power_operand(g);
+		int k;
+		switch(g() % 4){
+			case 0:  k = x.second; break;
+			case 1:  k = x.second % 2 ? x.second : x.second / 2; break;
+			case 2:  k = 2*x.second; break;
+			default: k = 1 + static_cast<int>(g() % 40);
+		}
+		differ_roots< Integer<int> >(check, "vector", x.first, k);
+		differ_roots< Integer<int, SharedContainer<int> > >(check, "SharedContainer", x.first, k);
+	}
+
+	//every base from 2 to 36 on numbers either side of its powers and of 2^32 and 2^64, then a random base
+	//for each random operand; the digits past a base, a sign alone or doubled or trailing, and the empty
+	//string must be rejected, as must bases outside 2 to 36
+	const char* RADIX[] = {"0", "1", "-1", "4294967295", "4294967296", "-18446744073709551615", "18446744073709551616"};
+	const char* MALFORMED[] = {"", "-", "--1", "1-", "1 2", " 1"};
+	for(int base=2; base<=36; ++base){
+		for(std::size_t i=0; i<sizeof(RADIX)/sizeof(RADIX[0]); ++i)
+			differ_radix< Integer<int> >(check, "vector", RADIX[i], base);
+		const Ref power = Ref::pow(Ref::parse(std::to_string(base)), 1 + static_cast<int>(g() % 40));
+		differ_radix< Integer<int> >(check, "vector", power.str(), base);
+		differ_radix< Integer<int> >(check, "vector", (power - Ref::parse("1")).str(), base);
+		differ_radix< Integer<int> >(check, "vector", (-power - Ref::parse("1")).str(), base);
+		for(std::size_t i=0; i<sizeof(MALFORMED)/sizeof(MALFORMED[0]); ++i)
+			reject_radix< Integer<int> >(check, "vector", MALFORMED[i], base);
+		const char beyond[] = {SYMBOLS[base], static_cast<char>(std::toupper(SYMBOLS[base])), '/', ':', '@', '[', '`'};
+		for(std::size_t i=0; i<sizeof(beyond); ++i)
+			reject_radix< Integer<int> >(check, "vector", std::string("-1") + beyond[i] + "0", base);
+	}
+	const int BASES[] = {-10, -1, 0, 1, 37, 62, 100};
+	for(std::size_t i=0; i<sizeof(BASES)/sizeof(BASES[0]); ++i)
+		reject_radix< Integer<int> >(check, "vector", "1", BASES[i]);
+	for(long c=0; c<cases/10; ++c){
+		const std::string a = sign(g, operand(g));
+		const int base = 2 + static_cast<int>(g() % 35);
+		differ_radix< Integer<int> >(check, "vector", a, base);
+		differ_radix< Integer<int, std::deque<int> > >(check, "deque", a, base);
+	}
+
+	std::cout << check.cases << " checks, " << check.mismatches << " mismatches"
+#ifdef INTEGER_TEST_GMP
+	          << ", Ref checked against GMP"
+#endif
+	          << std::endl;
+
+	bool slow = false;
+	if(timing){
+		//a generator of its own, so that the operands timed do not depend on --cases
+		std::mt19937_64 t(seed);
+		const Timings now = time_buckets(t, std::cout);
+		if(!baseline.empty()){
+			const Timings before = load(baseline);
+			for(Timings::const_iterator i = now.begin(); i != now.end(); ++i){
+				Timings::const_iterator j = before.find(i->first);
+				if(j != before.end() && i->second > slowdown * j->second){
+					slow = true;
+					std::cerr << "SLOWER " << i->first.first << " at " << i->first.second << " digits: "
+					          << i->second << "s against " << j->second << "s in " << baseline << std::endl;
+				}
+			}
+		}
+		if(!save.empty()){
+			std::ofstream out(save.c_str());
+			for(Timings::const_iterator i = now.begin(); i != now.end(); ++i)
+				out << i->first.first << " " << i->first.second << " " << i->second << "\n";
+		}
+	}
+	return check.mismatches || slow ? EXIT_FAILURE : EXIT_SUCCESS;}
@@ -0,0 +1,120 @@
+// -------------------------------
+// integer/tests/divide_stress.cpp
+// Tj Wrenn
+// -------------------------------
+
+// divides by shared, read only divisors on THREADS threads at once, so that any write to a divisor or a
+// shared dividend shows up under ThreadSanitizer (make -C tests tsan) and any torn result as a mismatch
+// against the answers worked out on one thread beforehand
+
+// --------
+// includes
+// --------
+
+#include <atomic>    // atomic
+#include <cstdlib>   // EXIT_FAILURE, EXIT_SUCCESS
+#include <iostream>  // cerr, cout
+#include <sstream>   // ostringstream
+#include <string>    // string
+#include <thread>    // thread, yield
+#include <vector>    // vector
+
+#include "Integer.h"
+#include "SharedContainer.h"
+
+namespace {
+	const int THREADS = 32;
+	const int ROUNDS  = 20;
+
+	template <typename I>
+	std::string str (const I& x) {
+		std::ostringstream out;
+		out << x;
+		return out.str();}
+
+	/**
+	* @return a number of n digits that is the same on every run
+	*/
+	std::string digits (std::size_t n, unsigned seed) {
+		std::string s(n, '0');
+		for(std::size_t i=0; i<n; ++i){
+			seed = seed*1103515245u + 12345u;
+			s[i] = static_cast<char>('0' + (seed >> 16) % 10);
+		}
+		s[0] = '7';
+		return s;}
+
+	template <typename I>
+	struct Case {
+		I           x;
+		std::string q;
+		std::string r;
+		std::string n;   // x / -d
+		std::string one; // x / ONE
+	};
+
+	/**
+	* @return the number of mismatches across every thread
+	*/
+	template <typename I>
+	int stress (const char* name) {
+		//the shared divisors: short enough for the one word path, long enough for long division
+		//and for Karatsuba in the checks, and ONE itself
+		std::vector<I> divisors;
+		divisors.push_back(I(digits(9, 1)));
+		divisors.push_back(I(digits(17, 2)));
+		divisors.push_back(I(digits(18, 3)));
+		divisors.push_back(I(digits(60, 4)));
+		divisors.push_back(I(digits(400, 5)));
+		divisors.push_back(I::ONE);
+
+		//the shared dividends, and the answers worked out on this thread alone
+		std::vector< std::vector< Case<I> > > cases(divisors.size());
+		for(std::size_t j=0; j<divisors.size(); ++j){
+			for(unsigned k=0; k<4; ++k){
+				Case<I> c = {I(digits(50 + 300*k, 10*j + k)), "", "", "", ""};
+				c.q   = str(c.x / divisors[j]);
+				c.r   = str(c.x % divisors[j]);
+				c.n   = str(c.x / -divisors[j]);
+				c.one = str(c.x / I::ONE);
+				cases[j].push_back(c);
+			}
+		}
+		const std::vector<I>&                        d  = divisors;
+		const std::vector< std::vector< Case<I> > >& cs = cases;
+
+		std::atomic<int>  bad(0);
+		std::atomic<int>  ready(0);
+		std::vector<std::thread> threads;
+		for(int t=0; t<THREADS; ++t)
+			threads.push_back(std::thread([&d, &cs, &bad, &ready, t] () {
+				//start together, so that the divisions overlap as much as they can
+				++ready;
+				while(ready < THREADS) std::this_thread::yield();
+				for(int round=0; round<ROUNDS; ++round){
+					const std::size_t j = (t + round) % d.size();
+					for(std::size_t k=0; k<cs[j].size(); ++k){
+						const Case<I>& c = cs[j][k];
+						I q = c.x;
+						q /= d[j];
+						I r = c.x;
+						r %= d[j];
+						if(str(q) != c.q || str(r) != c.r || str(c.x / -d[j]) != c.n || str(c.x / I::ONE) != c.one)
+							++bad;
+						if(q * d[j] + r != c.x)
+							++bad;
+					}
+				}}));
+		for(std::size_t t=0; t<threads.size(); ++t)
+			threads[t].join();
+
+		std::cout << name << ": " << THREADS << " threads, " << bad << " mismatches" << std::endl;
+		return bad;}
+}
+
+int main () {
+	using namespace alg::prog::integer;
+	int bad = 0;
+	bad += stress< Integer<int> >("vector");
+	bad += stress< Integer<int, SharedContainer<int> > >("SharedContainer");
+	return bad ? EXIT_FAILURE : EXIT_SUCCESS;}
@@ -0,0 +1,153 @@
+// ----------------------------
+// integer/tests/hash_cache.cpp
+// Tj Wrenn
+// ----------------------------
+
+// built with INTEGER_CACHE_HASH: hashes an Integer, changes its digits through a reference or iterator
+// from the non-const begin, end, operator [] or at, taken before or after the hash, and through moves and
+// swaps of the Integer holding those digits, then fails if the Integer's hash differs from that of a
+// fresh Integer parsed from its value.  make -C tests hash runs it.
+
+// --------
+// includes
+// --------
+
+#include <cstdlib>   // EXIT_FAILURE, EXIT_SUCCESS
+#include <deque>     // deque
+#include <iostream>  // cout
+#include <string>    // string
+#include <utility>   // move
+
+#include "Integer.h"
+#include "SharedContainer.h"
+
+#ifndef INTEGER_CACHE_HASH
+#error hash_cache checks the cached hash, so it must be built with -DINTEGER_CACHE_HASH
+#endif
+
+namespace {
+	const std::string DIGITS = "9081726354453627180919283746556473829101";
+	const std::string OTHER  = "1234567890123456789012345678901234567";
+
+	template <typename I>
+	struct Regression {
+		const char* name;
+		int         bad;
+
+		/**
+		* fails unless x hashes as a fresh Integer of the same value does; copying x would copy its
+		* cached hash too, so the fresh one is parsed from x's digits
+		*/
+		void expect (const char* what, const I& x) {
+			if(x.hash() == I(x.to_string()).hash()) return;
+			++bad;
+			std::cout << name << ": stale hash after " << what << std::endl;}
+
+		void run () {
+			{
+				I x(DIGITS);
+				x.hash();
+				*x.begin() = 1;
+				expect("writing through begin()", x);
+			}
+			{
+				I x(DIGITS);
+				x.hash();
+				*--x.end() = 5;
+				expect("writing through end()", x);
+			}
+			{
+				I x(DIGITS);
+				x.hash();
+				x[3] = (x[3] + 1) % 10;
+				expect("writing through operator []", x);
+			}
+			{
+				I x(DIGITS);
+				x.hash();
+				x.at(5) = (x.at(5) + 1) % 10;
+				expect("writing through at()", x);
+			}
+			{
+				I x(DIGITS);
+				typename I::iterator i = x.begin();
+				x.hash();
+				*i = 2;
+				expect("writing through an iterator taken before hashing", x);
+			}
+			{
+				I x(DIGITS);
+				typename I::reference r = x[2];
+				x.hash();
+				r = 7;
+				x.hash();
+				r = 8;
+				expect("writing twice through a reference taken before hashing", x);
+			}
+			{
+				I x(DIGITS);
+				typename I::iterator i = x.begin();
+				I y(std::move(x));
+				y.hash();
+				*i = 3;
+				expect("writing through an iterator into a move constructed Integer", y);
+			}
+			{
+				I x(DIGITS);
+				typename I::iterator i = x.begin();
+				I y(OTHER);
+				y.hash();
+				y = std::move(x);
+				y.hash();
+				*i = 4;
+				expect("writing through an iterator into a move assigned Integer", y);
+			}
+			{
+				I x(DIGITS);
+				typename I::iterator i = x.begin();
+				I y(OTHER);
+				y.hash();
+				y.swap(x);
+				x.hash();
+				y.hash();
+				*i = 6;
+				expect("writing through an iterator into a swapped Integer", y);
+				expect("swapping away digits with a live iterator", x);
+			}
+			{
+				I x(DIGITS);
+				I y(OTHER);
+				typename I::iterator i = y.begin();
+				x.hash();
+				using std::swap;
+				swap(x, y);
+				x.hash();
+				*i = 9;
+				expect("writing through an iterator into an Integer swapped by std::swap", x);
+			}
+			{
+				//without handles the hash is cached, and each operator must still drop it
+				I x(DIGITS);
+				const I y(OTHER);
+				x.hash(); x += y; expect("+=", x);
+				x.hash(); x -= y; expect("-=", x);
+				x.hash(); x *= y; expect("*=", x);
+				x.hash(); x /= y; expect("/=", x);
+				x.hash(); x %= y; expect("%=", x);
+				x.hash(); x = -x; expect("negation", x);
+				x.hash(); ++x;    expect("++", x);
+				x.hash(); x *= x; expect("x *= x", x);
+			}
+			std::cout << name << ": " << bad << " stale hashes" << std::endl;}
+	};
+}
+
+int main () {
+	using namespace alg::prog::integer;
+	Regression< Integer<int> >                         v = {"vector", 0};
+	Regression< Integer<int, std::deque<int> > >       d = {"deque", 0};
+	Regression< Integer<int, SharedContainer<int> > >  s = {"SharedContainer", 0};
+	v.run();
+	d.run();
+	s.run();
+	return v.bad + d.bad + s.bad ? EXIT_FAILURE : EXIT_SUCCESS;}
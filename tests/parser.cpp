@@ -0,0 +1,252 @@
+// ------------------------
+// integer/tests/parser.cpp
+// Tj Wrenn
+// ------------------------
+
+// checks areDigits, through the Parser, with every byte at every place in its eight, then feeds a Parser
+// numbers of up to 40 characters, with and without a sign and leading zeros, split into two chunks at
+// every place and into runs of one to nine characters, each chunk in a buffer of its own so that
+// AddressSanitizer catches a read past it.  A non-digit at every place must be rejected.  operator >>
+// must read the same numbers and ones either side of its 4096 character chunk, stop at the first
+// non-digit, and leave its target alone when there are no digits.  read() must take numbers from a pipe
+// with whitespace around them, written a few characters at a time, in paced reads or past the pipe's
+// buffer, and reject whitespace or a non-digit inside them, including whitespace that ends one read or
+// one 65536 byte chunk of a regular file.  make -C tests parse runs it under AddressSanitizer.
+
+// --------
+// includes
+// --------
+
+#include <algorithm> // min
+#include <csignal>   // signal, SIGPIPE, SIG_IGN
+#include <chrono>    // milliseconds
+#include <cstdlib>   // EXIT_FAILURE, EXIT_SUCCESS, mkstemp
+#include <fstream>   // ofstream
+#include <iostream>  // cout
+#include <random>    // mt19937_64
+#include <sstream>   // istringstream, ostringstream
+#include <stdexcept> // invalid_argument
+#include <string>    // string, to_string
+#include <thread>    // sleep_for, thread
+#include <vector>    // vector
+
+#include <unistd.h>  // close, pipe, unlink, write
+
+#include "IntegerIO.h"
+
+namespace {
+	using namespace alg::prog::integer;
+	typedef Integer<int> integer;
+
+	int bad = 0;
+
+	void fail (const std::string& what) {
+		++bad;
+		std::cout << "FAIL " << what << std::endl;}
+
+	std::string str (const integer& x) {
+		std::ostringstream out;
+		out << x;
+		return out.str();}
+
+	/**
+	* @return s as operator << would print it: without leading zeros, and without the sign of zero
+	*/
+	std::string canonical (const std::string& s) {
+		const std::size_t first = !s.empty() && '-' == s[0];
+		std::size_t i = first;
+		while(i + 1 < s.size() && '0' == s[i]) ++i;
+		const std::string digits = s.substr(i);
+		return first && digits != "0" ? "-" + digits : digits;}
+
+	/**
+	* feeds s to a Parser in chunks of the sizes in sizes, repeated, each copied into a buffer of exactly
+	* its size
+	* @return what the Parser made of s, or "throws"
+	*/
+	std::string parse (const std::string& s, const std::vector<std::size_t>& sizes) {
+		integer::Parser p;
+		try {
+			std::size_t at = 0;
+			for(std::size_t k=0; at < s.size(); ++k) {
+				const std::size_t n = std::min(sizes[k % sizes.size()], s.size() - at);
+				std::vector<char> chunk(s.begin() + at, s.begin() + at + n);
+				p.feed(chunk.data(), chunk.data() + n);
+				at += n;}
+			return str(p.finish());
+		}
+		catch(const std::invalid_argument&) {
+			return "throws";
+		}}
+
+	/**
+	* @param pause how long to wait after each piece, long enough for the reader to take it as a read
+	* of its own
+	* @return what read() makes of pieces written one after another to a pipe, or "throws"
+	*/
+	std::string from_pipe (const std::vector<std::string>& pieces, std::chrono::milliseconds pause = std::chrono::milliseconds(0)) {
+		int fds[2];
+		if(::pipe(fds) < 0) return "pipe";
+		std::thread writer([&pieces, &fds, pause] () {
+			for(std::size_t i=0; i<pieces.size(); ++i) {
+				if(i) std::this_thread::sleep_for(pause);
+				for(std::size_t at = 0; at < pieces[i].size(); ) {
+					const ssize_t n = ::write(fds[1], pieces[i].data() + at, pieces[i].size() - at);
+					if(n <= 0) break;
+					at += n;}}
+			::close(fds[1]);});
+		std::string r;
+		integer x(42);
+		try {
+			read(fds[0], x);
+			r = str(x);
+		}
+		catch(const std::invalid_argument&) {
+			r = x == integer(42) ? "throws" : "throws, changing its target";
+		}
+		//a writer left with more than the pipe holds gets EPIPE once no one can read it
+		::close(fds[0]);
+		writer.join();
+		return r;}
+
+	/**
+	* @return what read() makes of s in a regular file, which it reads in whole chunks, or "throws"
+	*/
+	std::string from_file (const std::string& s) {
+		char path[] = "/tmp/integer_parser_XXXXXX";
+		const int fd = ::mkstemp(path);
+		if(fd < 0) return "mkstemp";
+		std::ofstream(path) << s;
+		::unlink(path);
+		std::string r;
+		try {
+			integer x(42);
+			read(fd, x);
+			r = str(x);
+		}
+		catch(const std::invalid_argument&) {
+			r = "throws";
+		}
+		::close(fd);
+		return r;}
+}
+
+int main () {
+	std::signal(SIGPIPE, SIG_IGN);
+	std::mt19937_64 g(1);
+
+	//areDigits, through a Parser that has had its first digit, so that each chunk of exactly eight bytes
+	//is checked by areDigits alone: each non-digit at each place among digits
+	{
+		std::vector<char> eight(8);
+		for(int place=0; place<8; ++place) {
+			for(int c=0; c<256; ++c) {
+				for(int i=0; i<8; ++i) eight[i] = static_cast<char>('0' + g() % 10);
+				eight[place] = static_cast<char>(c);
+				integer::Parser p;
+				bool digits = true;
+				try {
+					p.feed("5", "5" + 1);
+					p.feed(eight.data(), eight.data() + 8);
+					p.finish();
+				}
+				catch(const std::invalid_argument&) {
+					digits = false;
+				}
+				if(digits != ('0' <= c && c <= '9'))
+					fail("areDigits with byte " + std::to_string(c) + " at " + std::to_string(place));}}
+	}
+
+	//numbers of 1 to 40 characters, with and without a sign and leading zeros
+	std::vector<std::string> numbers;
+	for(std::size_t n=1; n<=40; ++n) {
+		std::string digits(n, '0');
+		for(std::size_t i=0; i<n; ++i) digits[i] = static_cast<char>('0' + g() % 10);
+		numbers.push_back(digits);
+		numbers.push_back("-" + digits);
+		numbers.push_back(std::string(n/2, '0') + digits.substr(n/2));
+		numbers.push_back("-" + std::string(n, '0'));}
+
+	for(std::size_t i=0; i<numbers.size(); ++i) {
+		const std::string& s = numbers[i];
+		const std::string expected = canonical(s);
+		//split in two at every place, then in runs of one to nine
+		for(std::size_t at=0; at<=s.size(); ++at) {
+			std::vector<std::size_t> sizes(1, at ? at : s.size());
+			sizes.push_back(s.size());
+			if(parse(s, sizes) != expected) fail("Parser on " + s + " split at " + std::to_string(at));}
+		for(std::size_t run=1; run<=9; ++run) {
+			if(parse(s, std::vector<std::size_t>(1, run)) != expected) fail("Parser on " + s + " in runs of " + std::to_string(run));}
+
+		//a non-digit at each place past the sign, whole and in runs of three, where - is only a sign at first
+		const char BAD[] = {'/', ':', ' ', 'a', '-', '\0', '\x80'};
+		for(std::size_t at = '-' == s[0]; at<s.size(); ++at) {
+			for(std::size_t b=0; b<sizeof(BAD); ++b) {
+				if(!at && '-' == BAD[b]) continue;
+				std::string t(s);
+				t[at] = BAD[b];
+				if(parse(t, std::vector<std::size_t>(1, t.size())) != "throws" || parse(t, std::vector<std::size_t>(1, 3)) != "throws")
+					fail("Parser took byte " + std::to_string(static_cast<unsigned char>(BAD[b])) + " at " + std::to_string(at) + " of " + s);}}
+
+		//operator >>, which stops at the first non-digit
+		std::istringstream in(s + "x7");
+		integer x(42);
+		if(!(in >> x) || str(x) != expected || in.get() != 'x') fail("operator >> on " + s);}
+
+	//operator >> either side of its chunk, and a failure that leaves its target alone
+	const std::size_t LENGTHS[] = {4095, 4096, 4097, 8191, 8192, 8193, 20000};
+	for(std::size_t i=0; i<sizeof(LENGTHS)/sizeof(LENGTHS[0]); ++i) {
+		std::string s(LENGTHS[i], '0');
+		for(std::size_t j=0; j<s.size(); ++j) s[j] = static_cast<char>('1' + g() % 9);
+		std::istringstream in("  \n-" + s);
+		integer x(42);
+		if(!(in >> x) || str(x) != "-" + s || !in.eof()) fail("operator >> on " + std::to_string(LENGTHS[i]) + " digits");}
+	const char* NONE[] = {"", "   ", "-", "- 5", "x5", "--5"};
+	for(std::size_t i=0; i<sizeof(NONE)/sizeof(NONE[0]); ++i) {
+		std::istringstream in(NONE[i]);
+		integer x(42);
+		if((in >> x) || x != integer(42)) fail(std::string("operator >> on \"") + NONE[i] + "\"");}
+
+	//read() from a pipe, the number and the whitespace around it written a few characters at a time
+	for(std::size_t i=0; i<numbers.size(); i+=3) {
+		const std::string s = " \t\n" + numbers[i] + " \n\t ";
+		for(std::size_t piece=1; piece<=9; piece+=4) {
+			std::vector<std::string> pieces;
+			for(std::size_t at=0; at<s.size(); at+=piece) pieces.push_back(s.substr(at, piece));
+			if(from_pipe(pieces) != canonical(numbers[i])) fail("read() from a pipe of " + numbers[i] + " in pieces of " + std::to_string(piece));}}
+	{
+		//more than a pipe holds, and more than read()'s chunk
+		std::string s(200000, '0');
+		for(std::size_t j=0; j<s.size(); ++j) s[j] = static_cast<char>('1' + g() % 9);
+		if(from_pipe(std::vector<std::string>(1, std::string(70000, ' ') + s + "\n\n")) != s) fail("read() from a pipe of 200000 digits");
+		if(from_pipe(std::vector<std::string>(1, s.substr(0, 100000) + " " + s.substr(100000))) != "throws") fail("read() took a space inside 200000 digits");
+	}
+	{
+		//whitespace that ends one read and digits that start the next, paced so that each piece is a read
+		const std::chrono::milliseconds pause(50);
+		const char* SPLIT[][2] = {{"12 ", "34"}, {"12", " 34"}, {" 12\n", "\n34 "}, {"-", " 5"}};
+		for(std::size_t i=0; i<sizeof(SPLIT)/sizeof(SPLIT[0]); ++i) {
+			if(from_pipe(std::vector<std::string>(SPLIT[i], SPLIT[i] + 2), pause) != "throws")
+				fail(std::string("read() took \"") + SPLIT[i][0] + SPLIT[i][1] + "\" in two reads");}
+		const char* JOINED[][3] = {{" 12", "34 ", "1234"}, {"-", "5", "-5"}, {"  ", "  7", "7"}, {"7", " \n", "7"}};
+		for(std::size_t i=0; i<sizeof(JOINED)/sizeof(JOINED[0]); ++i) {
+			if(from_pipe(std::vector<std::string>(JOINED[i], JOINED[i] + 2), pause) != JOINED[i][2])
+				fail(std::string("read() of \"") + JOINED[i][0] + JOINED[i][1] + "\" in two reads");}
+
+		//and where the chunks of a regular file meet
+		std::string s(1 << 16, '0');
+		for(std::size_t j=0; j<s.size(); ++j) s[j] = static_cast<char>('1' + g() % 9);
+		if(from_file(s.substr(1) + " " + s) != "throws") fail("read() took a space ending its first chunk");
+		if(from_file(s + " " + s) != "throws") fail("read() took a space starting its second chunk");
+		if(from_file(s.substr(1) + "  \n") != s.substr(1)) fail("read() of whitespace across its chunks");
+	}
+	const char* REJECTED[] = {"", " \n ", "-", "12 34", "12\n3", "1x2", " -5- ", "+5"};
+	for(std::size_t i=0; i<sizeof(REJECTED)/sizeof(REJECTED[0]); ++i) {
+		const std::string s = REJECTED[i];
+		if(from_pipe(std::vector<std::string>(1, s)) != "throws") fail("read() took \"" + s + "\"");
+		std::vector<std::string> pieces;
+		for(std::size_t at=0; at<s.size(); ++at) pieces.push_back(s.substr(at, 1));
+		if(from_pipe(pieces) != "throws") fail("read() took \"" + s + "\" a character at a time");}
+
+	std::cout << bad << " failures" << std::endl;
+	return bad ? EXIT_FAILURE : EXIT_SUCCESS;}
@@ -0,0 +1,247 @@
+// ------------------------
+// integer/tests/primes.cpp
+// Tj Wrenn
+// ------------------------
+
+// checks is_probable_prime against a sieve for every number below SWEEP, and next_prime for every number
+// either side of 10^6, where both move from trial division to Baillie-PSW and sieving windows.  Then it
+// searches above 10^6 for composites with no prime factor below 1000 that pass a strong Fermat test to
+// base 2, or a strong Lucas test with Selfridge's parameters, both worked out here in words, and fails
+// if any of them, a Carmichael number or a listed pseudoprime is called prime.  next_prime must also cross
+// the maximal prime gaps after 1693182318746371 and 1425172824437699411, each longer than a sieving
+// window, landing on each offset around the window's end.  When built with INTEGER_TEST_GMP, random
+// numbers of 7 to 300 digits, their next primes and products of two primes are checked against
+// mpz_probab_prime_p and mpz_nextprime.  make -C tests prime runs it.
+
+// --------
+// includes
+// --------
+
+#include <cmath>     // sqrt
+#include <cstdlib>   // EXIT_FAILURE, EXIT_SUCCESS
+#include <iostream>  // cout
+#include <random>    // mt19937_64
+#include <sstream>   // ostringstream
+#include <string>    // stoull, string, to_string
+#include <utility>   // swap
+#include <vector>    // vector
+
+#ifdef INTEGER_TEST_GMP
+#include <gmpxx.h>   // mpz_class
+#endif
+
+#include "IntegerPrime.h"
+
+namespace {
+	using namespace alg::prog::integer;
+	typedef Integer<int>       integer;
+	typedef unsigned long long word;
+
+	const word SWEEP  = 2000000;
+	const word SEARCH = 20000000;
+
+	int bad = 0;
+
+	void fail (const std::string& what) {
+		++bad;
+		std::cout << "FAIL " << what << std::endl;}
+
+	std::string str (const integer& x) {
+		std::ostringstream out;
+		out << x;
+		return out.str();}
+
+	// ------------
+	// word testing
+	// ------------
+
+	word mulmod (word a, word b, word n) {
+		return static_cast<word>(static_cast<unsigned __int128>(a) * b % n);}
+
+	word powmod (word a, word e, word n) {
+		word r = 1;
+		for(; e; e >>= 1, a = mulmod(a, a, n)) {
+			if(e & 1) r = mulmod(r, a, n);}
+		return r;}
+
+	word addmod (word a, word b, word n) {
+		return a >= n - b ? a - (n - b) : a + b;}
+
+	word submod (word a, word b, word n) {
+		return a >= b ? a - b : a + (n - b);}
+
+	word halfmod (word a, word n) {
+		return a & 1 ? (a >> 1) + (n >> 1) + 1 : a >> 1;}
+
+	/**
+	* @param n an odd number above 2, below 2^63
+	* @return true if n passes a strong Fermat test to base 2
+	*/
+	bool strong_base2 (word n) {
+		word d = n - 1;
+		int s = 0;
+		for(; !(d & 1); d >>= 1) ++s;
+		word y = powmod(2, d, n);
+		if(y == 1 || y == n - 1) return true;
+		while(--s) {
+			y = mulmod(y, y, n);
+			if(y == n - 1) return true;}
+		return false;}
+
+	/**
+	* @return the Jacobi symbol (a/n) for an odd n
+	*/
+	int jacobi (word a, word n) {
+		int j = 1;
+		for(a %= n; a; a %= n) {
+			for(; !(a & 1); a >>= 1) {
+				if((n & 7) == 3 || (n & 7) == 5) j = -j;}
+			std::swap(a, n);
+			if((a & 3) == 3 && (n & 3) == 3) j = -j;}
+		return n == 1 ? j : 0;}
+
+	/**
+	* @param n an odd number above 2, below 2^62, that is not a square
+	* @return true if n passes a strong Lucas test with P = 1 and Selfridge's D and Q
+	*/
+	bool strong_lucas (word n) {
+		long long D = 5;
+		for(;;) {
+			const word d = D < 0 ? n - static_cast<word>(-D) % n : static_cast<word>(D) % n;
+			const int j = jacobi(d, n);
+			if(j == 0) return false;
+			if(j == -1) break;
+			D = D < 0 ? 2-D : -2-D;}
+		const long long q = (1-D)/4;
+		const word mD = D < 0 ? n - static_cast<word>(-D) % n : static_cast<word>(D) % n;
+		const word mQ = q < 0 ? n - static_cast<word>(-q) % n : static_cast<word>(q) % n;
+
+		word k = n + 1;
+		int t = 0;
+		for(; !(k & 1); k >>= 1) ++t;
+		int bits = 64;
+		while(!(k >> (bits - 1) & 1)) --bits;
+		word U = 1, V = 1, Qk = mQ;
+		for(int b=bits-1; b--; ) {
+			U = mulmod(U, V, n);
+			V = submod(mulmod(V, V, n), addmod(Qk, Qk, n), n);
+			Qk = mulmod(Qk, Qk, n);
+			if(k >> b & 1) {
+				const word u = halfmod(addmod(U, V, n), n);
+				V = halfmod(addmod(mulmod(mD, U, n), V, n), n);
+				U = u;
+				Qk = mulmod(Qk, mQ, n);}}
+		if(U == 0 || V == 0) return true;
+		for(int r=1; r<t; ++r) {
+			V = submod(mulmod(V, V, n), addmod(Qk, Qk, n), n);
+			if(V == 0) return true;
+			Qk = mulmod(Qk, Qk, n);}
+		return false;}
+
+	/**
+	* fails if is_probable_prime calls any of numbers, all known to be composite, prime
+	*/
+	void composites (const char* what, const std::vector<std::string>& numbers) {
+		for(std::size_t i=0; i<numbers.size(); ++i) {
+			if(is_probable_prime(integer(numbers[i]))) fail(std::string(what) + " " + numbers[i] + " called prime");
+#ifdef INTEGER_TEST_GMP
+			if(mpz_probab_prime_p(mpz_class(numbers[i]).get_mpz_t(), 30)) fail(std::string(what) + " " + numbers[i] + " is prime to GMP");
+#endif
+		}}
+}
+
+int main () {
+	//composite[n] for n below SEARCH, and smooth[n] if n has a prime factor below 1000
+	std::vector<char> composite(SEARCH, 0);
+	std::vector<char> smooth(SEARCH, 0);
+	composite[0] = composite[1] = 1;
+	for(word p=2; p*p<SEARCH; ++p) {
+		if(composite[p]) continue;
+		for(word m=p*p; m<SEARCH; m+=p) composite[m] = 1;}
+	for(word p=2; p<1000; ++p) {
+		if(composite[p]) continue;
+		for(word m=p; m<SEARCH; m+=p) smooth[m] = 1;}
+
+	//every number below SWEEP
+	for(word n=0; n<SWEEP; ++n) {
+		if(is_probable_prime(integer(static_cast<int>(n))) == !composite[n]) continue;
+		fail("is_probable_prime(" + std::to_string(n) + ")");}
+
+	//next_prime on every number below 2*10^5 and within 2*10^4 of 10^6
+	word next = SWEEP;
+	while(composite[next]) ++next;
+	for(word n=SWEEP; n--; ) {
+		if(n < 200000 || (n > 980000 && n < 1020000)) {
+			if(next_prime(integer(static_cast<int>(n))) != integer(static_cast<int>(next)))
+				fail("next_prime(" + std::to_string(n) + ")");}
+		if(!composite[n]) next = n;}
+
+	//composites with no prime factor below 1000 that pass half of Baillie-PSW
+	std::vector<std::string> base2;
+	std::vector<std::string> lucas;
+	for(word n=1000001; n<SEARCH; n+=2) {
+		if(!composite[n] || smooth[n]) continue;
+		if(strong_base2(n)) base2.push_back(std::to_string(n));
+		word r = static_cast<word>(std::sqrt(static_cast<double>(n)));
+		while(r*r > n) --r;
+		while((r+1)*(r+1) <= n) ++r;
+		if(r*r != n && strong_lucas(n)) lucas.push_back(std::to_string(n));}
+	std::cout << base2.size() << " strong pseudoprimes to base 2 and " << lucas.size() << " strong Lucas pseudoprimes between 10^6 and " << SEARCH << std::endl;
+	if(base2.empty() || lucas.empty()) fail("the search found no pseudoprimes, so the word tests are broken");
+	composites("strong pseudoprime to base 2", base2);
+	composites("strong Lucas pseudoprime", lucas);
+
+	//pseudoprimes beyond the search, each checked to pass base 2 here
+	const char* BASE2[] = {"2047", "3277", "4033", "4681", "8321", "3215031751", "2152302898747", "3474749660383",
+	                       "341550071728321", "3825123056546413051"};
+	std::vector<std::string> listed(BASE2, BASE2 + sizeof(BASE2)/sizeof(BASE2[0]));
+	for(std::size_t i=0; i<listed.size(); ++i) {
+		if(!strong_base2(std::stoull(listed[i]))) fail(listed[i] + " is not a strong pseudoprime to base 2");}
+	listed.push_back("318665857834031151167461");
+	listed.push_back("3317044064679887385961981");
+	composites("strong pseudoprime to base 2", listed);
+	const char* LUCAS[] = {"323", "377", "1159", "1829", "5459", "5777", "10877", "16109", "18971"};
+	composites("Lucas pseudoprime", std::vector<std::string>(LUCAS, LUCAS + sizeof(LUCAS)/sizeof(LUCAS[0])));
+
+	//Carmichael numbers, and Chernick's (6k+1)(12k+1)(18k+1), with all three factors above 1000 and prime
+	const char* CARMICHAEL[] = {"561", "1105", "1729", "2465", "2821", "6601", "8911", "41041", "62745", "63973"};
+	std::vector<std::string> carmichael(CARMICHAEL, CARMICHAEL + sizeof(CARMICHAEL)/sizeof(CARMICHAEL[0]));
+	for(word k=167; 18*k+1<SEARCH && carmichael.size()<30; ++k) {
+		if(composite[6*k+1] || composite[12*k+1] || composite[18*k+1]) continue;
+		carmichael.push_back(str(integer(static_cast<int>(6*k+1)) * integer(static_cast<int>(12*k+1)) * integer(static_cast<int>(18*k+1))));}
+	composites("Carmichael number", carmichael);
+
+	//maximal gaps longer than a window of 64 candidates per digit, entered at offsets either side of its end
+	const char* GAPS[][2] = {{"1693182318746371", "1693182318747503"}, {"1425172824437699411", "1425172824437700887"}};
+	for(std::size_t i=0; i<sizeof(GAPS)/sizeof(GAPS[0]); ++i) {
+		const integer before(GAPS[i][0]);
+		const integer after(GAPS[i][1]);
+		const int window = 64*static_cast<int>(before.size());
+		const int offsets[] = {0, window-1, window, window+1};
+		if(next_prime(before) != after) fail("next_prime(" + str(before) + ")");
+		for(std::size_t j=0; j<sizeof(offsets)/sizeof(offsets[0]); ++j) {
+			//next_prime sieves from x + 1, which puts after at offsets[j] into the windows
+			const integer x = after - integer(offsets[j] + 1);
+			if(next_prime(x) != after) fail("next_prime(" + str(x) + ")");}
+		if(!is_probable_prime(before) || !is_probable_prime(after)) fail("the ends of the gap after " + str(before));}
+
+#ifdef INTEGER_TEST_GMP
+	std::mt19937_64 g(1);
+	for(int c=0; c<300; ++c) {
+		std::string s(7 + g() % 294, '0');
+		for(std::size_t i=0; i<s.size(); ++i) s[i] = static_cast<char>('0' + g() % 10);
+		if(s[0] == '0') s[0] = '1';
+		const integer x(s);
+		const mpz_class z(s);
+		mpz_class p;
+		mpz_nextprime(p.get_mpz_t(), z.get_mpz_t());
+		const integer q = next_prime(x);
+		if(str(q) != p.get_str()) fail("next_prime(" + s + ") against mpz_nextprime");
+		if(is_probable_prime(x) != (mpz_probab_prime_p(z.get_mpz_t(), 30) != 0)) fail("is_probable_prime(" + s + ") against mpz_probab_prime_p");
+		if(!is_probable_prime(q)) fail("is_probable_prime(" + str(q) + ")");
+		const integer pq = q * next_prime(q);
+		if(is_probable_prime(pq)) fail("is_probable_prime(" + str(pq) + ")");}
+#endif
+
+	std::cout << bad << " failures" << std::endl;
+	return bad ? EXIT_FAILURE : EXIT_SUCCESS;}
@@ -0,0 +1,125 @@
+// --------------------------------
+// integer/tests/random_numbers.cpp
+// Tj Wrenn
+// --------------------------------
+
+// checks that random_bits(n) stays below 2^n and reaches its top bit, that random_digits(n) has exactly
+// n digits with every leading digit turning up, and that random_below(bound) lies in [0, bound) and
+// reaches both ends for small bounds, for bounds either side of the 18 digit chunks it draws, in
+// vector, deque and SharedContainer storage.  random_digits(0) and random_below of zero or a negative
+// bound must throw std::invalid_argument.  generate_random must fill a range with the same values for a
+// fixed seed on 1, 2, 3, 8, 32 and every core's worth of threads, and different ones for another seed.
+// make -C tests random runs it under ThreadSanitizer.
+
+// --------
+// includes
+// --------
+
+#include <cstdlib>   // EXIT_FAILURE, EXIT_SUCCESS
+#include <deque>     // deque
+#include <iostream>  // cout
+#include <random>    // mt19937_64
+#include <set>       // set
+#include <stdexcept> // invalid_argument
+#include <string>    // string, to_string
+#include <vector>    // vector
+
+#include "IntegerRandom.h"
+#include "SharedContainer.h"
+
+namespace {
+	using namespace alg::prog::integer;
+
+	int bad = 0;
+
+	void fail (const std::string& what) {
+		++bad;
+		std::cout << "FAIL " << what << std::endl;}
+
+	template <typename I>
+	struct Bounds {
+		const char* name;
+
+		void run (std::mt19937_64& g) {
+			typedef typename I::value_type T;
+			typedef typename I::container_type C;
+			const std::string n(name);
+
+			//random_bits(k) below 2^k, with the top bit set about half the time
+			const std::size_t BITS[] = {0, 1, 2, 31, 32, 33, 63, 64, 65, 100, 1000};
+			for(std::size_t i=0; i<sizeof(BITS)/sizeof(BITS[0]); ++i) {
+				const I top = pow(I(2), static_cast<int>(BITS[i]));
+				const I half = BITS[i] ? pow(I(2), static_cast<int>(BITS[i] - 1)) : I(1);
+				int high = 0;
+				for(int draw=0; draw<200; ++draw) {
+					const I x = random_bits<T, C>(BITS[i], g);
+					if(x < I::ZERO || x >= top) fail(n + " random_bits(" + std::to_string(BITS[i]) + ") gave " + x.to_string());
+					high += x >= half;}
+				if(BITS[i] && (high < 50 || high > 150)) fail(n + " random_bits(" + std::to_string(BITS[i]) + ") set its top bit " + std::to_string(high) + " times in 200");}
+
+			//random_digits(k) has exactly k digits, with every leading digit turning up
+			const std::size_t DIGITS[] = {1, 2, 17, 18, 19, 36, 37, 100, 1000};
+			for(std::size_t i=0; i<sizeof(DIGITS)/sizeof(DIGITS[0]); ++i) {
+				std::set<int> leading;
+				for(int draw=0; draw<200; ++draw) {
+					const I x = random_digits<T, C>(DIGITS[i], g);
+					if(x.size() != DIGITS[i] || x < I::ZERO) fail(n + " random_digits(" + std::to_string(DIGITS[i]) + ") gave " + x.to_string());
+					leading.insert(x[x.size() - 1]);}
+				if(leading.size() != 9) fail(n + " random_digits(" + std::to_string(DIGITS[i]) + ") led with " + std::to_string(leading.size()) + " digits");}
+			try {
+				random_digits<T, C>(0, g);
+				fail(n + " random_digits(0) did not throw");
+			}
+			catch(const std::invalid_argument&) {}
+
+			//random_below(bound) in [0, bound), reaching 0 and bound - 1 when bound is small
+			const char* BELOW[] = {"1", "2", "7", "10", "999999999999999999", "1000000000000000000", "1000000000000000001",
+			                       "9999999999999999999", "10000000000000000000", "100000000000000000000000000000000000001",
+			                       "999999999999999999999999999999999999", "123456789012345678901234567890123456789012345678901"};
+			for(std::size_t i=0; i<sizeof(BELOW)/sizeof(BELOW[0]); ++i) {
+				const I bound(BELOW[i]);
+				bool zero = false;
+				bool last = false;
+				for(int draw=0; draw<300; ++draw) {
+					const I x = random_below(bound, g);
+					if(x < I::ZERO || x >= bound) fail(n + " random_below(" + BELOW[i] + ") gave " + x.to_string());
+					zero = zero || x == I::ZERO;
+					last = last || x == bound - I::ONE;}
+				if(bound <= I(10) && !(zero && last)) fail(n + " random_below(" + BELOW[i] + ") missed an end");}
+			const char* NOT_POSITIVE[] = {"0", "-1", "-1000000000000000000000000000000"};
+			for(std::size_t i=0; i<sizeof(NOT_POSITIVE)/sizeof(NOT_POSITIVE[0]); ++i) {
+				try {
+					random_below(I(NOT_POSITIVE[i]), g);
+					fail(n + " random_below(" + NOT_POSITIVE[i] + ") did not throw");
+				}
+				catch(const std::invalid_argument&) {}}}
+	};
+
+	/**
+	* @return the values generate_random gives for seed on threads threads
+	*/
+	std::vector<std::string> generated (std::uint64_t seed, unsigned threads) {
+		std::vector<std::string> r(1000, "");
+		generate_random(r.begin(), r.end(), seed, [] (std::mt19937_64& g) {
+			return random_digits<int>(1 + g() % 40, g).to_string();}, threads);
+		return r;}
+}
+
+int main () {
+	std::mt19937_64 g(1);
+	Bounds< Integer<int> >                          v = {"vector"};
+	Bounds< Integer<int, std::deque<int> > >        d = {"deque"};
+	Bounds< Integer<int, SharedContainer<int> > >   s = {"SharedContainer"};
+	v.run(g);
+	d.run(g);
+	s.run(g);
+
+	//the same values whatever the number of threads, with 1000 elements ending part way into a block
+	const std::vector<std::string> one = generated(7, 1);
+	const unsigned THREADS[] = {2, 3, 8, 32, 0};
+	for(std::size_t i=0; i<sizeof(THREADS)/sizeof(THREADS[0]); ++i) {
+		if(generated(7, THREADS[i]) != one) fail("generate_random on " + std::to_string(THREADS[i]) + " threads differs from one thread");}
+	if(generated(8, 1) == one) fail("generate_random gave the same values for another seed");
+
+	std::cout << bad << " failures" << std::endl;
+	return bad ? EXIT_FAILURE : EXIT_SUCCESS;}
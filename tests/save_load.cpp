@@ -0,0 +1,182 @@
+// ---------------------------
+// integer/tests/save_load.cpp
+// Tj Wrenn
+// ---------------------------
+
+// saves numbers with save(), then checks that load() gives them back in vector, deque and SharedContainer
+// storage, and that an IntegerView of each file prints as, equals, compares and orders as the number in
+// memory does.  Files that are empty, a lone sign, signed twice, signed with +, or hold a non-digit must
+// be rejected with std::invalid_argument by both load() and IntegerView, leaving load()'s target as it
+// was, and a save() past RLIMIT_FSIZE must throw std::system_error.  make -C tests io runs it under
+// AddressSanitizer.
+
+// --------
+// includes
+// --------
+
+#include <csignal>      // signal, SIGXFSZ, SIG_IGN
+#include <cstdio>       // remove
+#include <cstdlib>      // EXIT_FAILURE, EXIT_SUCCESS, mkdtemp
+#include <deque>        // deque
+#include <fstream>      // ofstream
+#include <iostream>     // cout
+#include <random>       // mt19937_64
+#include <sstream>      // ostringstream
+#include <stdexcept>    // invalid_argument
+#include <string>       // string
+#include <system_error> // system_error
+#include <vector>       // vector
+
+#include <sys/resource.h> // rlimit, setrlimit, RLIMIT_FSIZE
+#include <sys/wait.h>     // waitpid, WEXITSTATUS, WIFEXITED
+#include <unistd.h>       // fork, _exit, rmdir
+
+#include "IntegerIO.h"
+#include "SharedContainer.h"
+
+namespace {
+	using namespace alg::prog::integer;
+	typedef Integer<int> integer;
+
+	int bad = 0;
+
+	void fail (const std::string& what) {
+		++bad;
+		std::cout << "FAIL " << what << std::endl;}
+
+	template <typename I>
+	std::string str (const I& x) {
+		std::ostringstream out;
+		out << x;
+		return out.str();}
+
+	int signum (int c) {
+		return (c > 0) - (c < 0);}
+
+	/**
+	* @return a number of n digits, the first of them not zero, and negative if asked
+	*/
+	std::string digits (std::mt19937_64& g, std::size_t n, bool negative) {
+		std::string s(n, '0');
+		for(std::size_t i=0; i<n; ++i)
+			s[i] = static_cast<char>('0' + g() % 10);
+		if(s[0] == '0') s[0] = '1';
+		return negative ? "-" + s : s;}
+
+	/**
+	* load()s path into I and fails unless it comes back as x
+	*/
+	template <typename I>
+	void round_trip (const char* name, const std::string& path, const integer& x) {
+		I y(42);
+		load(path, y);
+		if(str(y) != str(x))
+			fail(std::string("load into ") + name + " of " + str(x).substr(0, 40));}
+
+	/**
+	* fails unless both load() and IntegerView reject path, and load() leaves its target alone
+	*/
+	void malformed (const std::string& path, const std::string& text) {
+		std::ofstream(path.c_str()) << text;
+		integer x(42);
+		try {
+			load(path, x);
+			fail("load accepted \"" + text + "\"");
+		}
+		catch(const std::invalid_argument&) {
+			if(x != integer(42)) fail("load changed its target on \"" + text + "\"");
+		}
+		try {
+			IntegerView v(path);
+			fail("IntegerView accepted \"" + text + "\"");
+		}
+		catch(const std::invalid_argument&) {}}
+
+	/**
+	* in a child process, so that the limit goes with it: fails unless saving more than RLIMIT_FSIZE
+	* allows throws std::system_error rather than dying of SIGXFSZ or SIGBUS
+	*/
+	void out_of_space (const std::string& path) {
+		const pid_t child = ::fork();
+		if(child < 0) {
+			fail("fork");
+			return;}
+		if(!child){
+			std::signal(SIGXFSZ, SIG_IGN);
+			struct rlimit limit = {4096, 4096};
+			::setrlimit(RLIMIT_FSIZE, &limit);
+			int code = 1;
+			try {
+				save(path, pow(integer(7), 20000));
+			}
+			catch(const std::system_error&) {
+				code = 0;
+			}
+			::_exit(code);
+		}
+		int status = 0;
+		::waitpid(child, &status, 0);
+		if(!WIFEXITED(status) || WEXITSTATUS(status))
+			fail("save past RLIMIT_FSIZE did not throw std::system_error");
+		std::remove(path.c_str());}
+}
+
+int main () {
+	char dir[] = "/tmp/integer_save_load_XXXXXX";
+	if(!::mkdtemp(dir)) {
+		std::cout << "FAIL mkdtemp" << std::endl;
+		return EXIT_FAILURE;}
+	const std::string a = std::string(dir) + "/a";
+	const std::string b = std::string(dir) + "/b";
+
+	//round trips, and views compared against the numbers in memory and each other
+	std::mt19937_64 g(1);
+	std::vector<integer> values;
+	const std::size_t LENGTHS[] = {1, 2, 9, 17, 18, 100, 1000, 100000};
+	for(std::size_t i=0; i<sizeof(LENGTHS)/sizeof(LENGTHS[0]); ++i){
+		values.push_back(integer(digits(g, LENGTHS[i], false)));
+		values.push_back(integer(digits(g, LENGTHS[i], true)));
+	}
+	values.push_back(integer(0));
+	values.push_back(values[values.size() - 2] + integer::ONE); //equal lengths, one apart
+	for(std::size_t i=0; i<values.size(); ++i){
+		const integer& x = values[i];
+		save(a, x);
+		round_trip<integer>("vector", a, x);
+		round_trip< Integer<int, std::deque<int> > >("deque", a, x);
+		round_trip< Integer<int, SharedContainer<int> > >("SharedContainer", a, x);
+
+		const IntegerView v(a);
+		if(!(v == x) || v != x || !(x == v) || x != v) fail("IntegerView == " + str(x).substr(0, 40));
+		if(str(v) != str(x)) fail("IntegerView << " + str(x).substr(0, 40));
+		if(static_cast<integer>(v) != x) fail("IntegerView to Integer " + str(x).substr(0, 40));
+		for(std::size_t j=0; j<values.size(); j+=3){
+			const integer& y = values[j];
+			save(b, y);
+			const IntegerView w(b);
+			const int expected = x < y ? -1 : (y < x ? 1 : 0);
+			if(signum(compare(v, y)) != expected) fail("compare(IntegerView, Integer) " + str(x).substr(0, 40) + " " + str(y).substr(0, 40));
+			if(signum(compare(v, w)) != expected) fail("compare(IntegerView, IntegerView) " + str(x).substr(0, 40) + " " + str(y).substr(0, 40));
+			if((v < w) != (x < y)) fail("IntegerView < " + str(x).substr(0, 40) + " " + str(y).substr(0, 40));
+			if((v == w) != (x == y) || (v != y) != (x != y)) fail("IntegerView == " + str(x).substr(0, 40) + " " + str(y).substr(0, 40));
+		}
+	}
+
+	//what save() writes is not the only thing that loads: whitespace and leading zeros are allowed
+	std::ofstream(a.c_str()) << "  \n00012345 \n";
+	round_trip<integer>("vector", a, integer(12345));
+	std::ofstream(a.c_str()) << "-000";
+	round_trip<integer>("vector", a, integer(0));
+	if(str(IntegerView(a)) != "0") fail("IntegerView of -000");
+
+	const char* MALFORMED[] = {"", "-", "--5", "+5", "12a3", " \n ", "1 2", "5-"};
+	for(std::size_t i=0; i<sizeof(MALFORMED)/sizeof(MALFORMED[0]); ++i)
+		malformed(a, MALFORMED[i]);
+
+	out_of_space(b);
+
+	std::remove(a.c_str());
+	std::remove(b.c_str());
+	::rmdir(dir);
+	std::cout << bad << " failures" << std::endl;
+	return bad ? EXIT_FAILURE : EXIT_SUCCESS;}
@@ -0,0 +1,54 @@
+// -----------------------
+// integer/tests/timing.h
+// Tj Wrenn
+// -----------------------
+
+#ifndef timing_h
+#define timing_h
+
+// --------
+// includes
+// --------
+
+#include <algorithm> // min
+#include <chrono>    // duration, steady_clock
+
+// ------
+// timing
+// ------
+
+/**
+* @return the best of five runs of f, in seconds per call, each run calling f for at least 20 ms so
+* that the clock and the scheduler add little to it
+*/
+template <typename F>
+double best (F f) {
+	double r = 1e300;
+	for(int run=0; run<5; ++run){
+		const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		double elapsed = 0;
+		long   calls   = 0;
+		do {
+			f();
+			++calls;
+			elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		} while(elapsed < 0.02);
+		r = std::min(r, elapsed / calls);
+	}
+	return r;}
+
+/**
+* makes the compiler assume that x has changed, so that work on it is not hoisted out of a timed loop
+*/
+template <typename T>
+void opaque (T& x) {
+	asm volatile("" : "+m" (x));}
+
+/**
+* makes the compiler assume that x is read, so that work that only produces x is not thrown away
+*/
+template <typename T>
+void keep (const T& x) {
+	asm volatile("" : : "m" (x) : "memory");}
+
+#endif // timing_h